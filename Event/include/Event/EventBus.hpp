@@ -0,0 +1,180 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace kalika
+{
+  /**
+   * @brief Traffic of a single event type
+   */
+  struct ChannelStats {
+    char const* name;
+    // Events delivered by the last swap
+    std::size_t count = 0;
+    // Most events delivered by a single swap
+    std::size_t high_water = 0;
+    // Events delivered since the start
+    std::size_t total = 0;
+  };
+
+  /**
+   * @brief Event bus with one double-buffered channel per event type
+   *
+   * Events are published into the back buffer of their type. swap()
+   * makes everything published so far readable and starts a new back
+   * buffer, so events raised while handling a batch are delivered by the
+   * next swap. Buffers keep their capacity, so steady traffic does not
+   * allocate.
+   *
+   * Every event type needs a static `name` for the stats.
+   */
+  template<typename... Events> struct EventChannels {
+    static constexpr std::size_t channel_count = sizeof...(Events);
+
+    /**
+     * @brief Publish an event
+     */
+    template<typename Event> void emplace(Event const& event)
+    {
+      this->channel<Event>().back.push_back(event);
+    }
+
+    /**
+     * @brief Publish a batch of events of one type at once
+     */
+    template<std::ranges::contiguous_range Range>
+    void emplace_range(Range const& events)
+    {
+      using Event = std::ranges::range_value_t<Range>;
+      auto& back = this->channel<Event>().back;
+      back.insert(
+        back.end(), std::ranges::begin(events), std::ranges::end(events)
+      );
+    }
+
+    /**
+     * @brief Deliver everything published since the last swap
+     */
+    void swap() { (this->channel<Events>().swap(), ...); }
+
+    /**
+     * @brief Events of one type delivered by the last swap
+     */
+    template<typename Event> std::span<Event const> events() const
+    {
+      return this->channel<Event>().front;
+    }
+
+    /**
+     * @brief Hand each non-empty batch to the handler, one type at a
+     * time in declaration order
+     */
+    template<typename Handler> void drain(Handler&& handler) const
+    {
+      (
+        [&] {
+          auto const batch = this->events<Events>();
+          if (!batch.empty()) {
+            handler(batch);
+          }
+        }(),
+        ...
+      );
+    }
+
+    /**
+     * @brief Events of one type published and not yet delivered
+     */
+    template<typename Event> std::span<Event const> published() const
+    {
+      return this->channel<Event>().back;
+    }
+
+    /**
+     * @brief Call func.template operator()<Event>() for every event
+     * type, in declaration order
+     */
+    template<typename Func> static void for_each_type(Func&& func)
+    {
+      (func.template operator()<Events>(), ...);
+    }
+
+    /**
+     * @brief Number of events published and not yet delivered
+     */
+    std::size_t pending() const
+    {
+      return (this->channel<Events>().back.size() + ...);
+    }
+
+    /**
+     * @brief Drop every event, keeping the stats
+     */
+    void clear()
+    {
+      ((this->channel<Events>().back.clear(),
+        this->channel<Events>().front.clear()),
+       ...);
+    }
+
+    /**
+     * @brief Traffic of every event type, in declaration order
+     */
+    std::array<ChannelStats, channel_count> stats() const
+    {
+      return {this->channel<Events>().stats...};
+    }
+
+    template<typename Event> ChannelStats const& stats() const
+    {
+      return this->channel<Event>().stats;
+    }
+
+  private:
+    /**
+     * @brief Front and back buffer of one event type
+     */
+    template<typename Event> struct Channel {
+      std::vector<Event> front;
+      std::vector<Event> back;
+      ChannelStats stats{Event::name};
+
+      void swap()
+      {
+        this->front.swap(this->back);
+        this->back.clear();
+
+        this->stats.count = this->front.size();
+        this->stats.total += this->front.size();
+        this->stats.high_water =
+          std::max(this->stats.high_water, this->front.size());
+      }
+    };
+
+    std::tuple<Channel<Events>...> channels_;
+
+    template<typename Event> Channel<Event>& channel()
+    {
+      static_assert(
+        (std::is_same_v<Event, Events> || ...),
+        "Event type has no channel on this bus"
+      );
+      return std::get<Channel<Event>>(this->channels_);
+    }
+
+    template<typename Event> Channel<Event> const& channel() const
+    {
+      return std::get<Channel<Event>>(this->channels_);
+    }
+  };
+}  //namespace kalika
+
+#endif
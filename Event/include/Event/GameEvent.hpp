@@ -4,31 +4,26 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 
-#include <functional>
-#include <queue>
-#include <typeindex>
-#include <variant>
+#include <Event/EventBus.hpp>
+#include <Resource/Sprites.hpp>
+
+#include <cstdint>
 
 namespace kalika
 {
-  namespace internal
-  {
-    template<typename SubType, typename Variant>
-    inline constexpr bool contains_v = false;
-
-    template<typename SubType, typename... Types>
-    inline constexpr bool contains_v<SubType, std::variant<Types...>> =
-      (std::is_same_v<SubType, Types> || ...);
-  }  //namespace internal
+  // Compile-time id of a behaviour, see Object/Behaviour.hpp
+  using BehaviourId = std::uint8_t;
 
   /**
-   * @brief Event class
+   * @brief Event types carried by the event bus
    */
   struct GameEvent {
     /**
      * @brief Move the player
      */
     struct MoveEvent {
+      static constexpr char const* name = "move";
+
       sf::Vector2f l_strength;
       sf::Vector2f r_strength;
     };
@@ -37,32 +32,62 @@ namespace kalika
      * @brief Event representing player firing bullets
      */
     struct FireEvent {
+      static constexpr char const* name = "fire";
+
       // Phase
       sf::Vector2f position;
       sf::Vector2f velocity;
       // Sprite data
-      std::reference_wrapper<sf::Texture> texture;
+      SpriteId sprite;
       float size;
       // Behaviour data
-      std::type_index behaviour_id;
+      BehaviourId behaviour_id;
       // Game data
       float lifetime;
     };
 
+    /**
+     * @brief Many bullets fired at once in a fan or ring pattern
+     *
+     * Bullet i flies along forward rotated by start + i * step, spawning
+     * radius away from the origin.
+     */
+    struct BurstEvent {
+      static constexpr char const* name = "burst";
+
+      // Pattern
+      sf::Vector2f origin;
+      sf::Vector2f forward;
+      sf::Angle start;
+      sf::Angle step;
+      std::uint32_t count;
+      float radius;
+      float speed;
+      // Shared bullet data
+      SpriteId sprite;
+      float size;
+      BehaviourId behaviour_id;
+      float lifetime;
+    };
+
     /**
      * @brief Event representing enemies spawning
      */
     struct SpawnEvent {
+      static constexpr char const* name = "spawn";
+
       // Phase
       sf::Vector2f position;
       sf::Vector2f velocity;
       // Sprite data
       float size = 90.F;
-      std::reference_wrapper<sf::Texture> texture;
+      SpriteId sprite;
       // Behaviour data
-      std::type_index behaviour_id;
+      BehaviourId behaviour_id;
       // Lifetime data
       float health = 10.F;
+      // Seconds on the field, or negative to stay until killed
+      float lifetime = -1.F;
       // Animation data
       bool animate = true;
       size_t frame_count = 2UL;
@@ -70,63 +95,45 @@ namespace kalika
     };
 
     /**
-     * @brief Release an Object from the pool
+     * @brief Two objects overlapping, found by the collision pass
      */
-    struct ReleaseEvent {
+    struct HitEvent {
+      static constexpr char const* name = "hit";
+
+      enum class Kind : std::uint8_t {
+        // A bullet hit an enemy
+        BulletEnemy,
+      };
+
+      Kind kind;
+      // Partition of the bullet, for bullet hits
+      BehaviourId behaviour;
+      // Generational handle of the bullet
       size_t idx;
+      std::uint32_t gen;
+      // Generational handle of the enemy hit by a bullet
+      size_t target_idx;
+      std::uint32_t target_gen;
+      float damage;
     };
 
     /**
      * @brief Switch firing modes
      */
     struct SwitchEvent {
+      static constexpr char const* name = "switch";
+
       size_t fire_id;
     };
-
-    /**
-     * @brief Templated constructor
-     */
-    template<typename EventType>
-    explicit GameEvent(EventType const& event) : data_(event)
-    {}
-
-    /**
-     * @brief Check if event is of given type
-     */
-    template<typename EventType> [[nodiscard]] bool is() const
-    {
-      static_assert(is_subtype<EventType>, "Invalid type passed to Event");
-      return std::holds_alternative<EventType>(this->data_);
-    }
-
-    /**
-     * @brief Return event value if it is of given type
-     */
-    template<typename EventType> [[nodiscard]] EventType* is() const
-    {
-      static_assert(is_subtype<EventType>, "Invalid type passed to Event");
-      std::get_if<EventType>(this->data_);
-    }
-
-    /**
-     * @brief Apply a visitor
-     */
-    template<typename Visitor> void visit(Visitor&& v)
-    {
-      std::visit(std::forward<Visitor>(v), this->data_);
-    }
-
-  private:
-    std::
-      variant<FireEvent, SpawnEvent, ReleaseEvent, MoveEvent, SwitchEvent>
-        data_;
-
-    template<typename SubType>
-    static constexpr bool is_subtype =
-      internal::contains_v<SubType, decltype(data_)>;
   };
 
-  using EventBus = std::queue<GameEvent>;
+  using EventBus = EventChannels<
+    GameEvent::FireEvent,
+    GameEvent::BurstEvent,
+    GameEvent::SpawnEvent,
+    GameEvent::HitEvent,
+    GameEvent::MoveEvent,
+    GameEvent::SwitchEvent>;
 }  //namespace kalika
 
 #endif
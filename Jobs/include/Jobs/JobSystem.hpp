@@ -0,0 +1,132 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kalika
+{
+  /**
+   * @brief Worker threads running the chunks of parallel loops
+   *
+   * parallel_for cuts a range into chunks of a fixed size and deals them
+   * round-robin onto per-thread deques. Each thread pops from the back of
+   * its own deque and, once it runs dry, steals from the front of the
+   * others. The calling thread works too until every chunk is done.
+   *
+   * Chunk boundaries depend only on the range and the chunk size, never
+   * on the number of threads. Callers that keep per-chunk results and
+   * merge them in chunk order get the same outcome on any machine.
+   *
+   * parallel_for is called from one thread at a time and must not be
+   * nested.
+   */
+  struct JobSystem {
+    /**
+     * @brief Start threads - 1 workers; the caller is the last thread.
+     * One thread runs every loop inline.
+     */
+    explicit JobSystem(
+      size_t threads = std::max(1U, std::thread::hardware_concurrency())
+    );
+
+    ~JobSystem();
+
+    JobSystem(JobSystem const&) = delete;
+    JobSystem& operator=(JobSystem const&) = delete;
+
+    /**
+     * @brief Threads taking part in a loop, the caller included
+     */
+    size_t thread_count() const { return this->queues_.size(); }
+
+    /**
+     * @brief Number of chunks parallel_for cuts a range into
+     */
+    static size_t chunk_count(size_t count, size_t chunk)
+    {
+      return (count + chunk - 1) / chunk;
+    }
+
+    /**
+     * @brief Call func(chunk_index, begin, end) for every chunk of
+     * [0, count) and return once all of them are done. func is called
+     * from several threads at once, through a const reference.
+     */
+    template<typename Func>
+    void parallel_for(size_t count, size_t chunk, Func&& func)
+    {
+      Batch batch{
+        .invoke =
+          [](void const* ctx, size_t index, size_t begin, size_t end) {
+            using Target = std::remove_reference_t<Func> const;
+            (*static_cast<Target*>(ctx))(index, begin, end);
+          },
+        .ctx = &func,
+        .count = count,
+        .chunk = chunk,
+      };
+      this->run(batch);
+    }
+
+  private:
+    /**
+     * @brief A parallel loop in flight
+     */
+    struct Batch {
+      void (*invoke)(void const*, size_t, size_t, size_t);
+      void const* ctx;
+      size_t count;
+      size_t chunk;
+      // Chunks not finished yet
+      std::atomic<size_t> remaining = 0;
+    };
+
+    /**
+     * @brief One chunk of a batch
+     */
+    struct Job {
+      Batch* batch;
+      size_t index;
+    };
+
+    /**
+     * @brief Deque of a thread. The owner works from the back, thieves
+     * from the front.
+     */
+    struct Queue {
+      std::mutex mutex;
+      std::deque<Job> jobs;
+    };
+
+    // Queue 0 belongs to the calling thread
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    // Wakes workers when a batch is posted
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    // Bumped for every batch so sleeping workers notice it
+    std::size_t epoch_ = 0;
+    bool stop_ = false;
+
+    // Post a batch and help until it is done
+    void run(Batch& batch);
+    // Take a job from our own queue, or steal one
+    bool take(size_t self, Job& job);
+    // Run a single chunk
+    static void execute(Job const& job);
+    // Worker thread body
+    void work(size_t self);
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,134 @@
+#include <algorithm>
+
+#include <Jobs/JobSystem.hpp>
+
+namespace kalika
+{
+  // Start the workers
+  JobSystem::JobSystem(size_t threads)
+  {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; i++) {
+      this->queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 1; i < threads; i++) {
+      this->workers_.emplace_back([this, i] { this->work(i); });
+    }
+  }
+
+  // Stop and join the workers
+  JobSystem::~JobSystem()
+  {
+    {
+      std::scoped_lock const lock(this->wake_mutex_);
+      this->stop_ = true;
+    }
+    this->wake_.notify_all();
+    for (auto& worker : this->workers_) {
+      worker.join();
+    }
+  }
+
+  // Deal the chunks, then help
+  void JobSystem::run(Batch& batch)
+  {
+    auto const chunks = chunk_count(batch.count, batch.chunk);
+    if (chunks == 0) {
+      return;
+    }
+
+    batch.remaining.store(chunks, std::memory_order_relaxed);
+
+    // Not worth waking anyone
+    if (chunks == 1 || this->workers_.empty()) {
+      for (size_t index = 0; index < chunks; index++) {
+        execute({&batch, index});
+      }
+      return;
+    }
+
+    auto const threads = this->thread_count();
+    for (size_t q = 0; q < threads; q++) {
+      auto& queue = *this->queues_[q];
+      std::scoped_lock const lock(queue.mutex);
+      for (size_t index = q; index < chunks; index += threads) {
+        queue.jobs.push_back({&batch, index});
+      }
+    }
+    {
+      std::scoped_lock const lock(this->wake_mutex_);
+      this->epoch_++;
+    }
+    this->wake_.notify_all();
+
+    // Work until every chunk is taken, then wait for the stragglers
+    Job job{};
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+      if (this->take(0, job)) {
+        execute(job);
+      }
+      else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Own queue first, then steal round the others
+  bool JobSystem::take(size_t self, Job& job)
+  {
+    {
+      auto& own = *this->queues_[self];
+      std::scoped_lock const lock(own.mutex);
+      if (!own.jobs.empty()) {
+        job = own.jobs.back();
+        own.jobs.pop_back();
+        return true;
+      }
+    }
+
+    auto const threads = this->thread_count();
+    for (size_t step = 1; step < threads; step++) {
+      auto& victim = *this->queues_[(self + step) % threads];
+      std::scoped_lock const lock(victim.mutex);
+      if (!victim.jobs.empty()) {
+        job = victim.jobs.front();
+        victim.jobs.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Run a chunk and count it done
+  void JobSystem::execute(Job const& job)
+  {
+    auto& batch = *job.batch;
+    size_t const begin = job.index * batch.chunk;
+    size_t const end = std::min(begin + batch.chunk, batch.count);
+    batch.invoke(batch.ctx, job.index, begin, end);
+    batch.remaining.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  // Sleep until a batch is posted, then drain the queues
+  void JobSystem::work(size_t self)
+  {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock lock(this->wake_mutex_);
+        this->wake_.wait(lock, [&] {
+          return this->stop_ || this->epoch_ != seen;
+        });
+        if (this->stop_) {
+          return;
+        }
+        seen = this->epoch_;
+      }
+
+      Job job{};
+      while (this->take(self, job)) {
+        execute(job);
+      }
+    }
+  }
+}  //namespace kalika
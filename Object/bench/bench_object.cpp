@@ -0,0 +1,813 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <Event/GameEvent.hpp>
+#include <Object/Animation.hpp>
+#include <Object/Collision.hpp>
+#include <Object/Enemy.hpp>
+#include <Object/Kinematics.hpp>
+#include <Object/Particles.hpp>
+#include <Object/Player.hpp>
+#include <Object/Pool.hpp>
+#include <Object/Rewind.hpp>
+#include <Object/Snapshot.hpp>
+#include <Object/Targeting.hpp>
+#include <Object/World.hpp>
+#include <Resource/Resources.hpp>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Timing of a single benchmark
+   */
+  struct Result {
+    std::string name;
+    // Work items per iteration (bullets, events, ...)
+    size_t items;
+    size_t iterations;
+    double ns_per_iter;
+  };
+
+  /**
+   * @brief Run options
+   */
+  struct Options {
+    std::string filter;
+    std::string out;
+    std::string label;
+    double min_time = 0.5;
+    // Threads for the world update
+    size_t threads = std::max(1U, std::thread::hardware_concurrency());
+  };
+
+  // Run body until min_time has passed, after one warm-up iteration
+  template<typename Body>
+  Result measure(
+    Options const& opts, std::string name, size_t items, Body&& body
+  )
+  {
+    body();
+
+    size_t iterations = 0;
+    auto const start = Clock::now();
+    std::chrono::duration<double> elapsed{};
+    do {
+      body();
+      iterations++;
+      elapsed = Clock::now() - start;
+    } while (elapsed.count() < opts.min_time || iterations < 3);
+
+    return {
+      .name = std::move(name),
+      .items = items,
+      .iterations = iterations,
+      .ns_per_iter =
+        elapsed.count() * 1e9 / static_cast<double>(iterations),
+    };
+  }
+
+  // World and context used by the world benchmarks
+  struct Scene {
+    kalika::EventBus bus;
+    kalika::JobSystem jobs;
+    kalika::World world;
+    sf::Clock clock;
+    size_t frames = 0;
+    kalika::GameContext ctx;
+
+    Scene(size_t threads) :
+      jobs(threads),
+      world(
+        {
+          .position = {800.F, 500.F},
+          .velocity = {320.F, 0.F},
+          .dir = {0.F, -1.F},
+          .player_sprite = kalika::SpriteId::Player,
+          .reticle_sprite = kalika::SpriteId::Reticle,
+          .radius = 250.F,
+          .responsiveness = 4.F,
+        },
+        &this->bus,
+        &this->jobs
+      ),
+      ctx(
+        this->clock,
+        // Large enough that no bullet leaves during the run
+        {{-1e9F, -1e9F}, {2e9F, 2e9F}},
+        this->world.player,
+        this->frames
+      )
+    {}
+  };
+
+  // Fire event for a behaviour
+  kalika::GameEvent::FireEvent
+  fire_event(std::mt19937& gen, kalika::BehaviourId behaviour)
+  {
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::uniform_real_distribution<float> vel(-800.F, 800.F);
+    return {
+      .position = {pos(gen), pos(gen)},
+      .velocity = {vel(gen), vel(gen)},
+      .sprite = kalika::SpriteId::Bullet,
+      .size = kalika::bul_size,
+      .behaviour_id = behaviour,
+      .lifetime = 1e9F,
+    };
+  }
+
+  // World::update with a fixed number of bullets of one behaviour
+  template<typename Behaviour>
+  Result bench_world(Options const& opts, size_t count)
+  {
+    Scene scene(opts.threads);
+    std::mt19937 gen(7);
+    auto const behaviour = kalika::behaviour_id<Behaviour>;
+    for (size_t i = 0; i < count; i++) {
+      scene.world.add_bullet(fire_event(gen, behaviour));
+    }
+
+    auto const name = std::format(
+      "world_update/{}/{}",
+      std::is_same_v<Behaviour, kalika::Dasher> ? "dasher" : "chaser",
+      count
+    );
+    return measure(opts, name, count, [&] {
+      scene.world.update(scene.ctx, 1.F / 120.F);
+    });
+  }
+
+  // Integration kernel alone, per motion model and instruction set
+  Result bench_kernel(
+    Options const& opts,
+    kalika::internal::Motion motion,
+    kalika::internal::SimdLevel level,
+    size_t count
+  )
+  {
+    kalika::internal::Kinematics kin;
+    for (size_t i = 0; i < count; i++) {
+      kin.push(800.F, 500.F, 100.F, 100.F, 1e9F, (i % 2) * 500.F);
+    }
+    kalika::internal::StepParams const params{
+      .dt = 1.F / 120.F,
+      .left = -1e9F,
+      .top = -1e9F,
+      .width = 2e9F,
+      .height = 2e9F
+    };
+
+    auto const name = std::format(
+      "integrate/{}/{}/{}",
+      motion == kalika::internal::Motion::Homing ? "homing" : "straight",
+      kalika::internal::simd_name(level),
+      count
+    );
+    return measure(opts, name, count, [&] {
+      kalika::internal::integrate(kin, params, motion, level);
+    });
+  }
+
+  // Release and re-acquire pooled bullets
+  Result bench_pool(Options const& opts, size_t count)
+  {
+    Pool<kalika::Bullet> pool;
+    std::mt19937 gen(11);
+    auto const behaviour = kalika::behaviour_id<kalika::Dasher>;
+
+    std::vector<Handle> handles;
+    for (size_t i = 0; i < count; i++) {
+      handles.push_back(pool.acquire(fire_event(gen, behaviour)));
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    auto const event = fire_event(gen, behaviour);
+    auto const name = std::format("pool_churn/{}", count);
+    return measure(opts, name, 1000, [&] {
+      for (auto i = 0; i < 1000; i++) {
+        auto& handle = handles[pick(gen)];
+        pool.release(handle);
+        handle = pool.acquire(event);
+      }
+    });
+  }
+
+  // Spawn a burst one event at a time, as a batch, or as a pattern.
+  // Bullets die on the following update so every iteration starts empty.
+  Result bench_spawn(
+    Options const& opts, std::string_view mode, std::uint32_t count
+  )
+  {
+    Scene scene(opts.threads);
+    kalika::GameEvent::BurstEvent const burst{
+      .origin = {800.F, 500.F},
+      .forward = {0.F, -1.F},
+      .start = sf::degrees(0.F),
+      .step = sf::degrees(360.F / static_cast<float>(count)),
+      .count = count,
+      .radius = 40.F,
+      .speed = 300.F,
+      .sprite = kalika::SpriteId::Bullet,
+      .size = kalika::bul_size,
+      .behaviour_id = kalika::behaviour_id<kalika::Dasher>,
+      .lifetime = 0.F,
+    };
+
+    // The same ring as individual events
+    std::vector<kalika::GameEvent::FireEvent> events;
+    for (std::uint32_t i = 0; i < count; i++) {
+      auto const dir =
+        burst.forward.rotatedBy(burst.step * static_cast<float>(i));
+      events.push_back({
+        .position = burst.origin + (dir * burst.radius),
+        .velocity = dir * burst.speed,
+        .sprite = burst.sprite,
+        .size = burst.size,
+        .behaviour_id = burst.behaviour_id,
+        .lifetime = burst.lifetime,
+      });
+    }
+
+    auto const name = std::format("spawn/{}/{}", mode, count);
+    return measure(opts, name, count, [&] {
+      if (mode == "single") {
+        for (auto const& event : events) {
+          scene.world.add_bullet(event);
+        }
+      }
+      else if (mode == "bulk") {
+        scene.world.add_bullets(events);
+      }
+      else {
+        scene.world.add_burst(burst);
+      }
+      scene.world.update(scene.ctx, 1.F / 120.F);
+    });
+  }
+
+  // A swarm of enemies spawning on one tick, into a fresh pool or into
+  // one prewarmed to the swarm's size
+  Result bench_enemy_spawn(
+    Options const& opts, std::string_view mode, size_t count
+  )
+  {
+    kalika::EventBus bus;
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::vector<kalika::GameEvent::SpawnEvent> events;
+    for (size_t i = 0; i < count; i++) {
+      events.push_back({
+        .position = {pos(gen), pos(gen)},
+        .velocity = {0.F, 120.F},
+        .sprite = kalika::SpriteId::Chaser,
+        .behaviour_id = kalika::behaviour_id<kalika::Chaser>,
+      });
+    }
+
+    std::span<kalika::GameEvent::SpawnEvent const> const swarm = events;
+    Pool<kalika::Enemy> warm;
+    warm.prewarm(count, events.front(), &bus);
+
+    auto const name = std::format("enemy_spawn/{}/{}", mode, count);
+    return measure(opts, name, count, [&] {
+      if (mode == "cold") {
+        Pool<kalika::Enemy> pool;
+        pool.acquire_bulk(swarm, &bus);
+      }
+      else {
+        warm.acquire_bulk(swarm, &bus);
+        warm.release_if([](auto const&) { return true; });
+      }
+    });
+  }
+
+  // Strip animation of a crowd of enemies per tick, through the shared
+  // clock or recomputing and setting every frame per object
+  Result bench_animate(
+    Options const& opts, std::string_view mode, size_t count
+  )
+  {
+    kalika::EventBus bus;
+    std::vector<kalika::GameEvent::SpawnEvent> events;
+    for (size_t i = 0; i < count; i++) {
+      bool const chaser = i % 2 == 0;
+      events.push_back({
+        .position = {},
+        .velocity = {},
+        .sprite = chaser ? kalika::SpriteId::Chaser
+                         : kalika::SpriteId::Dasher,
+        .behaviour_id = chaser ? kalika::behaviour_id<kalika::Chaser>
+                               : kalika::behaviour_id<kalika::Dasher>,
+        .frame_count = chaser ? kalika::Chaser::frame_count
+                              : kalika::Dasher::frame_count,
+        .interval = chaser ? kalika::Chaser::interval
+                           : kalika::Dasher::interval,
+      });
+    }
+    std::span<kalika::GameEvent::SpawnEvent const> const crowd = events;
+
+    Pool<kalika::Enemy> enemies;
+    kalika::AnimationClock clock;
+    enemies.acquire_bulk(crowd, &bus);
+    for (auto& enemy : enemies) {
+      enemy.join(clock);
+    }
+
+    size_t tick = 0;
+    auto const name = std::format("animate/{}/{}", mode, count);
+    return measure(opts, name, count, [&] {
+      tick++;
+      if (mode == "clock") {
+        clock.step();
+        if (clock.any_changed()) {
+          for (auto& enemy : enemies) {
+            enemy.animate(clock);
+          }
+        }
+        return;
+      }
+      for (size_t i = 0; i < enemies.size(); i++) {
+        auto const& event = events[i];
+        auto const frame = (tick / event.interval) % event.frame_count;
+        enemies[i].sprite().setTextureRect(
+          kalika::atlas().region(event.sprite).frame(
+            static_cast<unsigned>(frame)
+          )
+        );
+      }
+    });
+  }
+
+  // Emission of a fire mode, with a spawn on every call
+  template<typename Mode>
+  Result bench_fire(Options const& opts, std::string_view mode_name)
+  {
+    Scene scene(opts.threads);
+    Mode mode;
+    size_t emitted = 0;
+
+    auto const name = std::format("fire/{}", mode_name);
+    auto result = measure(opts, name, 1000, [&] {
+      for (auto i = 0; i < 1000; i++) {
+        mode.fire(scene.ctx, mode.fire_interval, &scene.bus);
+      }
+      emitted = scene.bus.pending();
+      scene.bus.clear();
+    });
+    result.items = emitted;
+    return result;
+  }
+
+  // Publish, swap and drain fire events through the bus
+  Result bench_bus(Options const& opts, size_t count)
+  {
+    kalika::EventBus bus;
+    std::mt19937 gen(3);
+    auto const event =
+      fire_event(gen, kalika::behaviour_id<kalika::Dasher>);
+    size_t drained = 0;
+
+    auto const name = std::format("event_bus/{}", count);
+    return measure(opts, name, count, [&] {
+      for (size_t i = 0; i < count; i++) {
+        bus.emplace(event);
+      }
+      bus.swap();
+      bus.drain([&drained](auto events) { drained += events.size(); });
+    });
+  }
+
+  // Broadphase and narrowphase of bullets against a wave of enemies
+  Result bench_collide(Options const& opts, size_t bullets, size_t enemies)
+  {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> pos(0.F, 1920.F);
+    std::vector<float> xs;
+    std::vector<float> ys;
+    for (size_t i = 0; i < bullets; i++) {
+      xs.push_back(pos(gen));
+      ys.push_back(pos(gen));
+    }
+    kalika::Colliders colliders;
+    for (std::uint32_t e = 0; e < enemies; e++) {
+      colliders.push({pos(gen), pos(gen)}, 45.F, {e, 0});
+    }
+
+    kalika::Collisions coll;
+    coll.reset({{0.F, 0.F}, {1920.F, 1920.F}}, 64.F, kalika::bul_size / 2);
+    auto const name = std::format("collide/{}x{}", bullets, enemies);
+    return measure(opts, name, bullets, [&] {
+      coll.begin(colliders, {960.F, 960.F}, 36.F);
+      coll.add_bullets(0, xs, ys);
+    });
+  }
+
+  // Sparks of every hit in a crowded frame
+  std::vector<kalika::ParticleBurst> spark_bursts(size_t count)
+  {
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::vector<kalika::ParticleBurst> bursts;
+    for (size_t i = 0; i < count; i++) {
+      bursts.push_back({
+        .position = {pos(gen), pos(gen)},
+        .velocity = {},
+        .strength = kalika::bul_damage,
+        .kind = kalika::ParticleKind::Spark,
+      });
+    }
+    return bursts;
+  }
+
+  // Particle step, per instruction set. The step is short enough that
+  // no particle expires during the run.
+  Result bench_particles(
+    Options const& opts, kalika::internal::SimdLevel level, size_t count
+  )
+  {
+    kalika::ParticleSystem particles(count);
+    auto const per_burst = static_cast<size_t>(
+      kalika::style(kalika::ParticleKind::Spark).per_unit
+    );
+    particles.emit(spark_bursts(count / per_burst));
+
+    auto const name = std::format(
+      "particles/step/{}/{}", kalika::internal::simd_name(level), count
+    );
+    return measure(opts, name, particles.size(), [&] {
+      particles.update(1e-6F, level);
+    });
+  }
+
+  // Spawning the sparks of a batch of hits into an empty system
+  Result bench_particle_emit(Options const& opts, size_t hits)
+  {
+    kalika::ParticleSystem particles;
+    auto const bursts = spark_bursts(hits);
+    auto const name = std::format("particles/emit/{}", hits);
+    return measure(opts, name, hits, [&] {
+      particles.clear();
+      particles.emit(bursts);
+    });
+  }
+
+  // Target assignment for homing bullets. Cold runs drop every target
+  // first, so each bullet searches the grid.
+  Result bench_targeting(
+    Options const& opts, size_t bullets, size_t enemies, bool cold
+  )
+  {
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> pos(0.F, 1920.F);
+    sf::FloatRect const world = {{0.F, 0.F}, {1920.F, 1920.F}};
+
+    kalika::Colliders colliders;
+    for (std::uint32_t e = 0; e < enemies; e++) {
+      colliders.push({pos(gen), pos(gen)}, 45.F, {e, 0});
+    }
+    kalika::Collisions coll;
+    coll.reset(world, 64.F, kalika::bul_size / 2);
+    coll.begin(colliders, {960.F, 960.F}, 36.F);
+
+    kalika::internal::Kinematics kin;
+    for (size_t i = 0; i < bullets; i++) {
+      kin.push(pos(gen), pos(gen), 0.F, 100.F, 5.F, 500.F);
+    }
+
+    size_t tick = 0;
+    auto const name = std::format(
+      "targeting/{}/{}x{}", cold ? "cold" : "cached", bullets, enemies
+    );
+    return measure(opts, name, bullets, [&] {
+      if (cold) {
+        std::fill_n(kin.target.begin(), kin.size(), Handle{});
+        tick = 0;
+      }
+      for (size_t i = 0; i < kalika::retarget_interval; i++) {
+        kalika::assign_targets(
+          kin, coll.grid(), colliders, kalika::Chaser::range, tick++
+        );
+      }
+    });
+  }
+
+  // Reach a state of count bullets, by spawning them into an emptied
+  // world or by loading a mapped snapshot of it
+  Result
+  bench_snapshot(Options const& opts, std::string_view mode, size_t count)
+  {
+    Scene scene(opts.threads);
+    auto const dir = std::filesystem::temp_directory_path();
+    auto const empty_path = (dir / "kalika_bench_empty.ksnap").string();
+    auto const full_path = (dir / "kalika_bench_full.ksnap").string();
+    kalika::SnapshotWriter empty;
+    scene.world.write_snapshot(empty);
+    empty.save(empty_path.c_str());
+
+    // Half straight, half homing
+    std::mt19937 gen(11);
+    std::vector<kalika::GameEvent::FireEvent> events;
+    for (size_t i = 0; i < count; i++) {
+      events.push_back(fire_event(
+        gen,
+        i % 2 == 0 ? kalika::behaviour_id<kalika::Dasher>
+                   : kalika::behaviour_id<kalika::Chaser>
+      ));
+    }
+    scene.world.add_bullets(events);
+    kalika::SnapshotWriter full;
+    scene.world.write_snapshot(full);
+    full.save(full_path.c_str());
+
+    auto const start = kalika::SnapshotView::open(empty_path.c_str());
+    auto const state = kalika::SnapshotView::open(full_path.c_str());
+    auto const name = std::format("snapshot/{}/{}", mode, count);
+    auto result = measure(opts, name, count, [&] {
+      if (mode == "populate") {
+        scene.world.read_snapshot(*start);
+        scene.world.add_bullets(events);
+      }
+      else {
+        scene.world.read_snapshot(*state);
+      }
+    });
+    std::filesystem::remove(empty_path);
+    std::filesystem::remove(full_path);
+    return result;
+  }
+
+  // World::update alone, with a rewind capture after it, or a step
+  // back half a keyframe interval into the history
+  Result
+  bench_rewind(Options const& opts, std::string_view mode, size_t count)
+  {
+    Scene scene(opts.threads);
+    std::mt19937 gen(13);
+    for (size_t i = 0; i < count; i++) {
+      scene.world.add_bullet(fire_event(
+        gen,
+        i % 2 == 0 ? kalika::behaviour_id<kalika::Dasher>
+                   : kalika::behaviour_id<kalika::Chaser>
+      ));
+    }
+
+    kalika::RewindBuffer history(256UL << 20U);
+    kalika::SnapshotWriter out;
+    std::vector<std::byte> state;
+    std::uint64_t tick = 0;
+    auto const step = [&] {
+      scene.world.update(scene.ctx, 1.F / 120.F);
+      if (mode == "off") {
+        return;
+      }
+      out.clear();
+      scene.world.write_snapshot(out);
+      out.bytes(state);
+      history.capture(++tick, state);
+    };
+    if (mode == "seek") {
+      for (size_t i = 0; i < history.keyframe_interval(); i++) {
+        step();
+      }
+    }
+
+    auto const name = std::format("rewind/{}/{}", mode, count);
+    return measure(opts, name, count, [&] {
+      if (mode == "seek") {
+        (void)history.at(history.keyframe_interval() / 2);
+      }
+      else {
+        step();
+      }
+    });
+  }
+
+  // Write the results as JSON
+  void write_json(
+    std::ostream& out, Options const& opts, std::vector<Result> const& rs
+  )
+  {
+    out << "{\n";
+    out << std::format("  \"label\": \"{}\",\n", opts.label);
+    out << std::format(
+      "  \"simd\": \"{}\",\n",
+      kalika::internal::simd_name(kalika::internal::detect_simd())
+    );
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < rs.size(); i++) {
+      auto const& r = rs[i];
+      double const per_item =
+        r.ns_per_iter / static_cast<double>(std::max<size_t>(r.items, 1));
+      out << std::format(
+        "    {{\"name\": \"{}\", \"items\": {}, \"iterations\": {}, "
+        "\"ns_per_iter\": {:.1f}, \"ns_per_item\": {:.3f}, "
+        "\"items_per_sec\": {:.0f}}}{}\n",
+        r.name,
+        r.items,
+        r.iterations,
+        r.ns_per_iter,
+        per_item,
+        1e9 / per_item,
+        (i + 1 < rs.size()) ? "," : ""
+      );
+    }
+    out << "  ]\n}\n";
+  }
+
+  Options parse_options(int argc, char** argv)
+  {
+    Options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+      std::string_view const flag = argv[i];
+      if (flag == "--filter") {
+        opts.filter = argv[i + 1];
+      }
+      else if (flag == "--out") {
+        opts.out = argv[i + 1];
+      }
+      else if (flag == "--label") {
+        opts.label = argv[i + 1];
+      }
+      else if (flag == "--min-time") {
+        opts.min_time = std::atof(argv[i + 1]);
+      }
+      else if (flag == "--threads") {
+        opts.threads = std::strtoul(argv[i + 1], nullptr, 10);
+      }
+    }
+    return opts;
+  }
+}  //namespace
+
+int main(int argc, char** argv)
+{
+  auto const opts = parse_options(argc, argv);
+
+  // Benchmarks never open a window
+  kalika::ResourceManager::upload_textures = false;
+
+  // Every benchmark, in a stable order
+  using Bench = std::pair<std::string, std::function<Result()>>;
+  std::vector<Bench> benches;
+  for (size_t count : {1'000UL, 10'000UL, 100'000UL, 1'000'000UL}) {
+    benches.emplace_back(
+      std::format("world_update/dasher/{}", count),
+      [&, count] { return bench_world<kalika::Dasher>(opts, count); }
+    );
+    benches.emplace_back(
+      std::format("world_update/chaser/{}", count),
+      [&, count] { return bench_world<kalika::Chaser>(opts, count); }
+    );
+  }
+  // Thread scaling of the heaviest update
+  for (size_t threads : {1UL, 2UL, 4UL, 8UL, 16UL}) {
+    benches.emplace_back(
+      std::format("world_update/threads/{}", threads), [&, threads] {
+        auto scaled = opts;
+        scaled.threads = threads;
+        auto result = bench_world<kalika::Chaser>(scaled, 100'000UL);
+        result.name = std::format("world_update/threads/{}", threads);
+        return result;
+      }
+    );
+  }
+  using kalika::internal::Motion;
+  using kalika::internal::SimdLevel;
+  for (auto motion : {Motion::Straight, Motion::Homing}) {
+    for (auto level : {SimdLevel::Scalar,
+                       SimdLevel::Sse,
+                       SimdLevel::Avx2,
+                       SimdLevel::Avx512}) {
+      if (level > kalika::internal::detect_simd()) {
+        continue;
+      }
+      benches.emplace_back(
+        std::format(
+          "integrate/{}/{}",
+          motion == Motion::Homing ? "homing" : "straight",
+          kalika::internal::simd_name(level)
+        ),
+        [&, motion, level] {
+          return bench_kernel(opts, motion, level, 100'000UL);
+        }
+      );
+    }
+  }
+  benches.emplace_back("pool_churn", [&] {
+    return bench_pool(opts, 10'000UL);
+  });
+  for (std::string_view mode : {"single", "bulk", "burst"}) {
+    for (std::uint32_t count : {50U, 500U}) {
+      benches.emplace_back(
+        std::format("spawn/{}/{}", mode, count),
+        [&, mode, count] { return bench_spawn(opts, mode, count); }
+      );
+    }
+  }
+  for (auto mode : {"cold", "prewarmed"}) {
+    benches.emplace_back(
+      std::format("enemy_spawn/{}/500", mode),
+      [&, mode] { return bench_enemy_spawn(opts, mode, 500UL); }
+    );
+  }
+  for (auto mode : {"per_object", "clock"}) {
+    benches.emplace_back(
+      std::format("animate/{}/5000", mode),
+      [&, mode] { return bench_animate(opts, mode, 5000UL); }
+    );
+  }
+  benches.emplace_back("fire/rapid", [&] {
+    return bench_fire<kalika::RapidFire>(opts, "rapid");
+  });
+  benches.emplace_back("fire/spread", [&] {
+    return bench_fire<kalika::SpreadFire>(opts, "spread");
+  });
+  benches.emplace_back("fire/chaser", [&] {
+    return bench_fire<kalika::ChaserFire>(opts, "chaser");
+  });
+  benches.emplace_back("event_bus", [&] {
+    return bench_bus(opts, 10'000UL);
+  });
+  for (size_t count : {10'000UL, 100'000UL}) {
+    benches.emplace_back(
+      std::format("collide/{}x200", count),
+      [&, count] { return bench_collide(opts, count, 200UL); }
+    );
+  }
+  for (std::string_view mode : {"populate", "load"}) {
+    benches.emplace_back(
+      std::format("snapshot/{}/100000", mode),
+      [&, mode] { return bench_snapshot(opts, mode, 100'000UL); }
+    );
+  }
+  for (std::string_view mode : {"off", "capture", "seek"}) {
+    for (size_t count : {1'000UL, 100'000UL}) {
+      benches.emplace_back(
+        std::format("rewind/{}/{}", mode, count),
+        [&, mode, count] { return bench_rewind(opts, mode, count); }
+      );
+    }
+  }
+  for (auto level : {SimdLevel::Scalar,
+                     SimdLevel::Sse,
+                     SimdLevel::Avx2,
+                     SimdLevel::Avx512}) {
+    if (level > kalika::internal::detect_simd()) {
+      continue;
+    }
+    benches.emplace_back(
+      std::format(
+        "particles/step/{}", kalika::internal::simd_name(level)
+      ),
+      [&, level] { return bench_particles(opts, level, 100'000UL); }
+    );
+  }
+  benches.emplace_back("particles/emit", [&] {
+    return bench_particle_emit(opts, 1000UL);
+  });
+  for (bool cold : {false, true}) {
+    benches.emplace_back(
+      std::format("targeting/{}", cold ? "cold" : "cached"),
+      [&, cold] { return bench_targeting(opts, 10'000UL, 200UL, cold); }
+    );
+  }
+
+  // Run the selected benchmarks
+  std::vector<Result> results;
+  for (auto const& [name, bench] : benches) {
+    if (name.find(opts.filter) == std::string::npos) {
+      continue;
+    }
+    results.push_back(bench());
+    std::cerr << std::format(
+      "{:<32} {:>14.1f} ns/iter\n",
+      results.back().name,
+      results.back().ns_per_iter
+    );
+  }
+
+  if (opts.out.empty()) {
+    write_json(std::cout, opts, results);
+  }
+  else {
+    std::ofstream file(opts.out);
+    write_json(file, opts, results);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,78 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace kalika
+{
+  // Index of an animation group in the clock
+  using AnimGroup = std::uint16_t;
+
+  // Group of objects that do not animate
+  inline constexpr AnimGroup no_anim_group = 0xFFFF;
+
+  /**
+   * @brief Shared clock for strip animations
+   *
+   * Objects with the same cadence (ticks per frame and frame count) share
+   * a group, and every group steps once per tick with a countdown. Only
+   * a group whose frame changed needs its objects touched, so objects
+   * that sit between frames cost nothing, and a tick where no group
+   * changed can skip the objects altogether.
+   */
+  struct AnimationClock {
+    /**
+     * @brief Group of the cadence, created on first use. New groups
+     * start on frame 0.
+     */
+    AnimGroup group(std::size_t interval, unsigned frames);
+
+    /**
+     * @brief Advance every group by a tick
+     */
+    void step();
+
+    /**
+     * @brief Current frame of a group
+     */
+    unsigned frame(AnimGroup group) const
+    {
+      return this->groups_[group].frame;
+    }
+
+    /**
+     * @brief Check if the group changed frame on the last step
+     */
+    bool changed(AnimGroup group) const
+    {
+      return this->groups_[group].changed;
+    }
+
+    /**
+     * @brief Check if any group changed frame on the last step
+     */
+    bool any_changed() const { return this->any_changed_; }
+
+    /**
+     * @brief Number of groups
+     */
+    std::size_t group_count() const { return this->groups_.size(); }
+
+  private:
+    struct Group {
+      std::size_t interval;
+      unsigned frames;
+      // Ticks until the next frame
+      std::size_t left;
+      unsigned frame = 0;
+      bool changed = false;
+    };
+
+    std::vector<Group> groups_;
+    bool any_changed_ = false;
+  };
+}  //namespace kalika
+
+#endif
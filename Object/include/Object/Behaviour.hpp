@@ -3,11 +3,13 @@
 
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
+#include <array>
+#include <cstddef>
 #include <string_view>
-#include <typeindex>
-#include <unordered_map>
-#include <variant>
+#include <type_traits>
 
+#include <Event/GameEvent.hpp>
+#include <Object/Kinematics.hpp>
 #include <Object/helpers.hpp>
 
 namespace kalika
@@ -68,9 +70,13 @@ namespace kalika
    * @brief Straight path
    */
   struct Dasher : internal::BehaviourBase {
+    inline static constexpr char const* name = "dasher";
+    inline static constexpr auto sprite = SpriteId::Dasher;
     inline static constexpr auto abs_vel = 500.F;
     inline static constexpr auto frame_count = 2UL;
     inline static constexpr auto interval = 30UL;
+    inline static constexpr auto homing_factor = 0.F;
+    inline static constexpr auto motion = internal::Motion::Straight;
 
     /**
      * @brief Return the acceleration of the chaser object
@@ -106,28 +112,29 @@ namespace kalika
    * @brief Hunts down the nearest enemy
    */
   struct Chaser : public internal::BehaviourBase {
+    inline static constexpr char const* name = "chaser";
+    inline static constexpr auto sprite = SpriteId::Chaser;
     inline static constexpr auto abs_vel = 100.F;
     inline static constexpr auto frame_count = 4UL;
     inline static constexpr auto interval = 10UL;
     inline static constexpr auto homing_factor = 500.F;
+    inline static constexpr auto motion = internal::Motion::Homing;
+    // Furthest enemy it will lock on to
+    inline static constexpr auto range = 480.F;
 
     /**
-     * @brief Return the acceleration of the object
+     * @brief Return the acceleration of the object. Homing bullets turn
+     * by the same rate in the kernel.
      */
     [[nodiscard]] sf::Vector2f accel(
       internal::Movable const& self, internal::Movable const& target
     ) const
     {
       auto const dist_vec = target.pos - self.pos;
-      auto const dist_length = dist_vec.length();
-      auto const dot_prod = dist_vec.dot(self.up);
-      auto const angle_update = homing_factor *
-                                sqrtf(dist_length - dot_prod) /
-                                powf(dist_length, 1.5F);
-
-      // Update the bullet's velocity & position
-      auto const dir = (dist_vec.dot(self.right) > 0) ? 1.F : -1.F;
-      return dir * self.vel.perpendicular() * angle_update;
+      float const turn = internal::homing_turn<internal::Lane>(
+        dist_vec.x, dist_vec.y, self.up.x, self.up.y, homing_factor
+      );
+      return self.vel.perpendicular() * turn;
     }
 
     /**
@@ -149,21 +156,107 @@ namespace kalika
     }
   };
 
-  using Behaviour = std::variant<Dasher, Chaser>*;
-
-  static std::unordered_map<std::type_index, std::variant<Dasher, Chaser>>
-    behaviour_map = {
-      {std::type_index(typeid(Dasher)), Dasher()},
-      {std::type_index(typeid(Chaser)), Chaser()},
+  /**
+   * @brief Compile-time list of types
+   */
+  template<typename... Types> struct TypeList {
+    static constexpr std::size_t size = sizeof...(Types);
   };
 
-  // Get a behaviour associated with the type
-  inline Behaviour get_behaviour(std::type_index idx)
+  /**
+   * @brief Every behaviour. New behaviours are added here; their id is
+   * their position in the list.
+   *
+   * Bullets never call accel or bound_velocity: each partition runs the
+   * kernel of its behaviour's motion model, fed with the behaviour's
+   * data (homing_factor, range), and leaving the bounds kills a bullet.
+   * Those methods drive the enemies. A behaviour on an existing motion
+   * model only needs an entry here; a new motion model also needs a
+   * Motion value and a branch in the kernels, and any maths shared with
+   * accel belongs in a function over a vector type, like homing_turn.
+   */
+  using Behaviours = TypeList<Dasher, Chaser>;
+
+  inline constexpr std::size_t behaviour_count = Behaviours::size;
+
+  // Id of objects without a behaviour
+  inline constexpr BehaviourId no_behaviour = 0xFF;
+
+  namespace internal
   {
-    if (behaviour_map.contains(idx)) {
-      return &behaviour_map[idx];
-    }
-    return nullptr;
+    template<typename Type, typename List> struct IndexOf;
+
+    template<typename Type, typename... Types>
+    struct IndexOf<Type, TypeList<Types...>> {
+      static constexpr std::size_t value = [] {
+        constexpr std::array<bool, sizeof...(Types)> matches = {
+          std::is_same_v<Type, Types>...
+        };
+        std::size_t idx = 0;
+        while (idx < matches.size() && !matches[idx]) {
+          idx++;
+        }
+        return idx;
+      }();
+      static_assert(value < sizeof...(Types), "Type is not in the list");
+    };
+  }  //namespace internal
+
+  /**
+   * @brief Id of a behaviour, known at compile time
+   */
+  template<typename B>
+  inline constexpr BehaviourId behaviour_id =
+    static_cast<BehaviourId>(internal::IndexOf<B, Behaviours>::value);
+
+  /**
+   * @brief Call func.template operator()<B>() for every behaviour, in id
+   * order
+   */
+  template<typename Func> constexpr void for_each_behaviour(Func&& func)
+  {
+    [&]<typename... Bs>(TypeList<Bs...>) {
+      (func.template operator()<Bs>(), ...);
+    }(Behaviours{});
+  }
+
+  /**
+   * @brief Call func(B{}) for the behaviour with the given id. Returns
+   * fallback for unknown ids.
+   */
+  template<typename Result, typename Func>
+  Result visit_behaviour(BehaviourId id, Func&& func, Result fallback = {})
+  {
+    Result result = fallback;
+    [&]<typename... Bs>(TypeList<Bs...>) {
+      (void)((id == behaviour_id<Bs> && (result = func(Bs{}), true)) ||
+             ...);
+    }(Behaviours{});
+    return result;
+  }
+
+  /**
+   * @brief Homing strength of a behaviour
+   */
+  inline float homing_factor(BehaviourId id)
+  {
+    return visit_behaviour<float>(id, [](auto behaviour) {
+      return decltype(behaviour)::homing_factor;
+    });
+  }
+
+  /**
+   * @brief Id of the behaviour with the given name, or no_behaviour
+   */
+  inline BehaviourId find_behaviour(std::string_view name)
+  {
+    BehaviourId found = no_behaviour;
+    for_each_behaviour([&]<typename B>() {
+      if (name == B::name) {
+        found = behaviour_id<B>;
+      }
+    });
+    return found;
   }
 
 }  // namespace kalika
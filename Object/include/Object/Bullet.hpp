@@ -1,36 +1,47 @@
 #ifndef BULLET_H
 #define BULLET_H
 
-#include <type_traits>
-
 #include <Event/GameEvent.hpp>
-#include <Object/ObjBase.hpp>
+#include <Object/helpers.hpp>
 
 namespace kalika
 {
-  struct Bullet : internal::ObjBase {
-    // Lifetime of the object
-    float lifetime_;
+  /**
+   * @brief Sprite of a bullet, for snapshots
+   */
+  struct BulletLook {
+    SpriteId sprite;
+    float size;
+  };
 
+  /**
+   * @brief Render side of a pooled bullet
+   *
+   * Everything the update touches lives in the columns of
+   * internal::Kinematics, so the pool only holds what drawing needs.
+   */
+  struct Bullet {
     // Constructor
-    Bullet(GameEvent::FireEvent event, EventBus* bus);
+    explicit Bullet(GameEvent::FireEvent const& event);
+
+    // Rebuild an inactive object
+    void rebuild(GameEvent::FireEvent const& event);
+
+    sf::Sprite const& sprite() const { return this->draw_.sprite; }
+
+    BulletLook look() const { return {this->draw_.id, this->size_}; }
 
     /**
-     * @brief Update the object status by a frame
+     * @brief Write the transform to the sprite if it changed
      */
-    void update(GameContext const& ctx, float dt);
-
-    // Rebuild an inactive object
-    void rebuild(GameEvent::FireEvent event, EventBus* bus);
+    void sync_sprite(sf::Vector2f position, sf::Vector2f dir)
+    {
+      this->draw_.sync(position, dir);
+    }
 
   private:
-    // Check if the bullet is alive and toggle it
-    void check_alive(GameContext const& ctx);
-    // // Find the enemy closest to the bullet and retrieve its target
-    // internal::Movable const& find_closest(GameContext const& ctx)
-    // {
-    //   return ctx.enemies[0].mov;
-    // }
+    internal::Drawable draw_;
+    float size_;
   };
 }  //namespace kalika
 
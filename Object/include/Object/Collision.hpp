@@ -0,0 +1,165 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Jobs/JobSystem.hpp>
+#include <Object/Behaviour.hpp>
+#include <Object/Pool.hpp>
+#include <Object/SpatialGrid.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Circle colliders of one kind of object, stored as columns
+   */
+  struct Colliders {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> radius;
+    // Object owning each collider
+    std::vector<Handle> owner;
+
+    void clear();
+
+    void push(sf::Vector2f pos, float r, Handle handle);
+
+    /**
+     * @brief Collider of an object, or npos if it has none this tick
+     */
+    slot_id find(Handle handle) const
+    {
+      if (handle.idx >= this->slots_.size()) {
+        return npos;
+      }
+      slot_id const slot = this->slots_[handle.idx];
+      return (slot != npos && this->owner[slot] == handle) ? slot : npos;
+    }
+
+    size_t size() const { return this->x.size(); }
+
+  private:
+    // Collider of every owner, indexed by the owner's slot
+    std::vector<slot_id> slots_;
+  };
+
+  /**
+   * @brief A bullet overlapping an enemy
+   */
+  struct Contact {
+    // Partition and dense slot of the bullet
+    BehaviourId behaviour;
+    slot_id bullet;
+    // Index of the enemy collider
+    std::uint32_t enemy;
+  };
+
+  /**
+   * @brief Finds bullets hitting enemies and enemies hitting the player
+   *
+   * Enemies are few and bullets many, so the enemies go in a uniform
+   * grid rebuilt every tick, grown by the bullet radius, and every bullet
+   * only tests the enemies of its own cell. Bullets are read straight
+   * from their kinematics columns and never copied. There is a single
+   * player, so enemies are tested against it directly. A bullet hits at
+   * most one enemy: the first one, in collider order, that it overlaps.
+   */
+  struct Collisions {
+    /**
+     * @brief Place the grid over the world. Every bullet shares the
+     * radius.
+     */
+    void reset(sf::FloatRect world, float cell_size, float bullet_radius);
+
+    /**
+     * @brief Start a tick: bucket the enemies and test them against the
+     * player
+     */
+    void begin(
+      Colliders const& enemies, sf::Vector2f player, float radius
+    );
+
+    /**
+     * @brief Test the bullets of a partition, given their positions in
+     * dense order
+     */
+    void add_bullets(
+      BehaviourId id, std::span<float const> px, std::span<float const> py
+    );
+
+    /**
+     * @brief Test the bullets of a partition in chunks spread over the
+     * job system. Contacts come out in the same order as the serial
+     * version, whatever the number of threads.
+     */
+    void add_bullets(
+      BehaviourId id,
+      std::span<float const> px,
+      std::span<float const> py,
+      JobSystem& jobs,
+      size_t chunk
+    );
+
+    /**
+     * @brief Bullet/enemy overlaps found since begin
+     */
+    std::span<Contact const> contacts() const { return this->contacts_; }
+
+    /**
+     * @brief Enemies bucketed by begin, for other spatial queries
+     */
+    SpatialGrid const& grid() const { return this->grid_; }
+
+    /**
+     * @brief Enemies overlapping the player
+     */
+    std::span<std::uint32_t const> player_hits() const
+    {
+      return this->player_hits_;
+    }
+
+    /**
+     * @brief Candidate pairs the broadphase handed to the narrowphase
+     */
+    size_t candidates() const { return this->candidates_; }
+
+  private:
+    SpatialGrid grid_;
+    float bullet_radius_ = 0.F;
+    // Enemy radii grown by the bullet radius
+    std::vector<float> reach_;
+
+    std::vector<Contact> contacts_;
+    std::vector<std::uint32_t> player_hits_;
+    size_t candidates_ = 0;
+
+    /**
+     * @brief Contacts of one chunk of bullets
+     */
+    struct ChunkResult {
+      std::vector<Contact> contacts;
+      size_t candidates = 0;
+    };
+
+    // Reused across ticks
+    std::vector<ChunkResult> chunks_;
+
+    // Test the bullets in [begin, end), appending to out. Returns the
+    // number of candidates.
+    size_t test_bullets(
+      BehaviourId id,
+      std::span<float const> px,
+      std::span<float const> py,
+      size_t begin,
+      size_t end,
+      std::vector<Contact>& out
+    ) const;
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef ENEMY_H
+#define ENEMY_H
+
+#include <Event/GameEvent.hpp>
+#include <Object/ObjBase.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Flat record of a live enemy, for snapshots
+   */
+  struct EnemyState {
+    // Spawn parameters, with the current phase, health and lifetime
+    GameEvent::SpawnEvent spawn;
+    sf::Vector2f up;
+    sf::Vector2f prev_pos;
+  };
+
+  /**
+   * @brief Pooled enemy steered by its behaviour
+   *
+   * Enemies are few next to bullets, so they keep their state in the
+   * object and move through the behaviour's accel and bound_velocity.
+   */
+  struct Enemy : internal::ObjBase {
+    // Constructor
+    Enemy(GameEvent::SpawnEvent const& event, EventBus* bus);
+
+    // Bring back an enemy saved by state()
+    Enemy(EnemyState const& state, EventBus* bus);
+
+    // Rebuild an inactive object
+    void rebuild(GameEvent::SpawnEvent const& event, EventBus* bus);
+
+    /**
+     * @brief Flat copy of the enemy's state
+     */
+    EnemyState state() const;
+
+    /**
+     * @brief Steer towards the target, step and count down the lifetime
+     */
+    void update(
+      GameContext const& ctx, internal::Movable const& target, float dt
+    );
+
+    /**
+     * @brief Take damage. Returns true once the enemy is dead.
+     */
+    bool damage(float amount);
+
+    /**
+     * @brief Write the transform to the sprite, interpolated by alpha
+     * between the previous and the current tick
+     */
+    void sync_render(float alpha);
+
+    /**
+     * @brief Radius of the enemy's hit circle
+     */
+    float radius() const { return this->radius_; }
+
+    float health() const { return this->health_; }
+
+    /**
+     * @brief Id of the enemy's behaviour
+     */
+    BehaviourId behaviour() const { return this->behaviour_; }
+
+  private:
+    float radius_;
+    float health_;
+    // Seconds left on the field, or negative to stay until killed
+    float life_;
+    // Position before the last tick, for render interpolation
+    sf::Vector2f prev_pos_;
+  };
+}  //namespace kalika
+
+#endif
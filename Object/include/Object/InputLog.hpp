@@ -0,0 +1,118 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include <Event/GameEvent.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Player input handled on one tick
+   */
+  struct InputFrame {
+    // Fields of the frame that are set
+    static constexpr std::uint8_t has_move = 1U;
+    static constexpr std::uint8_t has_switch = 2U;
+
+    // Tick the input was handled on, counted from 1
+    std::uint32_t tick = 0;
+    std::uint8_t mask = 0;
+    sf::Vector2f l_strength{};
+    sf::Vector2f r_strength{};
+    std::uint32_t fire_id = 0;
+  };
+
+  /**
+   * @brief Input stream of a session
+   *
+   * Only ticks where the controls changed are kept. Handlers keep the
+   * latest event of a tick, so one frame per tick replays exactly what
+   * the simulation saw. The binary layout is
+   *
+   *     header: "KINP" version dt width height ticks frames
+   *     frame:  tick mask [l.x l.y r.x r.y] [fire_id]
+   *
+   * with native 32-bit fields, so a log replays bit for bit on the
+   * build and machine that recorded it.
+   */
+  struct InputLog {
+    static constexpr std::uint32_t version = 1;
+
+    // Tick length and world size of the session
+    float dt = 0.F;
+    sf::Vector2u dimensions;
+    // Ticks the session ran for
+    std::uint32_t ticks = 0;
+    std::vector<InputFrame> frames;
+
+    /**
+     * @brief Remember the stick positions handled on a tick. Positions
+     * equal to the last recorded ones are dropped.
+     */
+    void record(std::uint32_t tick, GameEvent::MoveEvent const& event);
+
+    /**
+     * @brief Remember a fire mode switch handled on a tick
+     */
+    void record(std::uint32_t tick, GameEvent::SwitchEvent const& event);
+
+    /**
+     * @brief Write the log in its binary layout
+     */
+    bool write(std::ostream& out) const;
+
+    bool save(char const* path) const;
+
+    /**
+     * @brief Read a log written by write(). Fails on a bad header or a
+     * truncated stream.
+     */
+    static std::optional<InputLog> read(std::istream& in);
+
+    static std::optional<InputLog> load(char const* path);
+
+  private:
+    // Frame of the tick, appended if the tick has none yet
+    InputFrame& frame(std::uint32_t tick);
+
+    // Last recorded stick positions
+    std::optional<GameEvent::MoveEvent> last_move_;
+  };
+
+  /**
+   * @brief Plays a log back onto the event bus
+   */
+  struct InputReplay {
+    // Constructor. The log must outlive the replay.
+    explicit InputReplay(InputLog const& log) : log_(&log) {}
+
+    /**
+     * @brief Publish the input handled on the tick
+     */
+    void feed(std::uint32_t tick, EventBus& bus);
+
+    /**
+     * @brief Check if the tick is past the end of the recording
+     */
+    bool done(std::uint32_t tick) const
+    {
+      return tick >= this->log_->ticks;
+    }
+
+    InputLog const& log() const { return *this->log_; }
+
+  private:
+    InputLog const* log_;
+    // Next frame to publish
+    size_t cursor_ = 0;
+  };
+}  //namespace kalika
+
+#endif
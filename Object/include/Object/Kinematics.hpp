@@ -0,0 +1,355 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Object/Pool.hpp>
+
+namespace kalika::internal
+{
+  /**
+   * @brief Instruction sets the integration kernel can run on
+   */
+  enum class SimdLevel : std::uint8_t { Scalar, Sse, Avx2, Avx512 };
+
+  /**
+   * @brief Motion model of a behaviour, picked at compile time
+   */
+  enum class Motion : std::uint8_t {
+    // Constant velocity; heading never changes
+    Straight,
+    // Turns towards the target every step
+    Homing,
+  };
+
+  /**
+   * @brief Plain floats behind the interface of the kernel vector types,
+   * so maths written once for the kernels also runs one object at a time
+   */
+  struct Lane {
+    using reg = float;
+    using mask = bool;
+    static constexpr size_t width = 1;
+
+    static reg set1(float f) { return f; }
+
+    static reg add(reg a, reg b) { return a + b; }
+
+    static reg sub(reg a, reg b) { return a - b; }
+
+    static reg mul(reg a, reg b) { return a * b; }
+
+    static reg div(reg a, reg b) { return a / b; }
+
+    static reg sqrt(reg a) { return std::sqrt(a); }
+
+    static reg max(reg a, reg b) { return std::fmax(a, b); }
+
+    static mask gt(reg a, reg b) { return a > b; }
+
+    static reg select(mask m, reg a, reg b) { return m ? a : b; }
+  };
+
+  /**
+   * @brief Signed turn rate of the homing motion model
+   *
+   * The velocity turns by its perpendicular times this rate, towards
+   * the side the target is on, harder the further the target is off
+   * the heading. Bullet kernels, their scalar reference and homing
+   * enemies all call this one copy.
+   *
+   * @param distx, disty Offset from the object to its target
+   * @param upx, upy Unit heading
+   * @param strength Homing factor of the behaviour
+   */
+  template<typename V>
+  typename V::reg homing_turn(
+    typename V::reg distx,
+    typename V::reg disty,
+    typename V::reg upx,
+    typename V::reg upy,
+    typename V::reg strength
+  )
+  {
+    auto const zero = V::set1(0.F);
+    auto const one = V::set1(1.F);
+    auto const eps = V::set1(1e-3F);
+
+    auto const len =
+      V::sqrt(V::add(V::mul(distx, distx), V::mul(disty, disty)));
+    auto const dot_up = V::add(V::mul(distx, upx), V::mul(disty, upy));
+    auto const dot_right = V::sub(V::mul(disty, upx), V::mul(distx, upy));
+    // A target on top of the object gives no turn rather than a NaN
+    auto const safe_len = V::max(len, eps);
+    auto const lag = V::sqrt(V::max(V::sub(len, dot_up), zero));
+    auto const turn = V::div(
+      V::mul(strength, lag), V::mul(safe_len, V::sqrt(safe_len))
+    );
+    auto const side =
+      V::select(V::gt(dot_right, zero), one, V::sub(zero, one));
+    return V::mul(side, V::select(V::gt(len, eps), turn, zero));
+  }
+
+  /**
+   * @brief Per-tick inputs of the integration kernel
+   */
+  struct StepParams {
+    float dt;
+    // World boundary, matching GameContext::world_size
+    float left, top, width, height;
+  };
+
+  /**
+   * @brief Raw column pointers handed to the integration kernels
+   */
+  struct KinematicsView {
+    // Phase
+    float* px;
+    float* py;
+    float* vx;
+    float* vy;
+    // Heading
+    float* dx;
+    float* dy;
+    // Homing target and strength
+    float const* tx;
+    float const* ty;
+    float const* homing;
+    // Lifetime
+    float* life;
+    std::uint32_t* alive;
+    // Number of lanes, padded to a multiple of Kinematics::lanes
+    size_t count;
+  };
+
+  /**
+   * @brief Bytes a store spends per object
+   */
+  struct Footprint {
+    // Columns the kernel streams every tick
+    size_t hot;
+    // Columns only spawning, rendering and targeting read
+    size_t cold;
+  };
+
+  /**
+   * @brief Structure-of-arrays store for bullet kinematics
+   *
+   * Index i of every column describes the same object. Columns are padded
+   * to a whole number of the widest vector so the kernels never need a
+   * scalar tail. A straight store never steers, so its target, tx, ty
+   * and homing columns stay empty.
+   */
+  struct Kinematics {
+    // Widest vector width in floats
+    static constexpr size_t lanes = 16;
+
+    // Constructor
+    explicit Kinematics(Motion motion = Motion::Homing) :
+      steers_(motion == Motion::Homing)
+    {}
+
+    std::vector<float> px, py, vx, vy;
+    // Position before the last step, for render interpolation
+    std::vector<float> ox, oy;
+    std::vector<float> dx, dy;
+    std::vector<float> life;
+    std::vector<std::uint32_t> alive;
+    // Steering, homing stores only
+    std::vector<float> tx, ty, homing;
+    // Enemy each homing object chases, kept across ticks
+    std::vector<Handle> target;
+
+    /**
+     * @brief Bytes per object of a store of the given motion
+     */
+    static constexpr Footprint footprint(Motion motion)
+    {
+      // Position, velocity, lifetime and the alive mask, plus the
+      // previous position save_positions copies every tick
+      size_t hot = (7 * sizeof(float)) + sizeof(std::uint32_t);
+      // Heading
+      size_t cold = 2 * sizeof(float);
+      if (motion == Motion::Homing) {
+        // Steering reads and rewrites the heading every tick
+        hot += 5 * sizeof(float);
+        cold += sizeof(Handle) - (2 * sizeof(float));
+      }
+      return {.hot = hot, .cold = cold};
+    }
+
+    /**
+     * @brief Append an object and return its index
+     */
+    size_t push(
+      float pos_x,
+      float pos_y,
+      float vel_x,
+      float vel_y,
+      float lifetime,
+      float homing_factor
+    );
+
+    /**
+     * @brief Append count objects in one go and return the index of the
+     * first. They must be initialised with set().
+     */
+    size_t extend(size_t count);
+
+    /**
+     * @brief Initialise the object at idx
+     */
+    void set(
+      size_t idx,
+      float pos_x,
+      float pos_y,
+      float vel_x,
+      float vel_y,
+      float lifetime,
+      float homing_factor
+    );
+
+    /**
+     * @brief Remove an object by moving the last one into its place
+     */
+    void swap_remove(size_t idx);
+
+    /**
+     * @brief Remember the current positions before a step
+     */
+    void save_positions();
+
+    void save_positions(size_t begin, size_t end);
+
+    /**
+     * @brief Check if the object survived the last step
+     */
+    bool is_alive(size_t idx) const { return this->alive[idx] != 0U; }
+
+    /**
+     * @brief Number of objects in the store
+     */
+    size_t size() const { return this->count_; }
+
+    /**
+     * @brief Check if the store has the steering columns
+     */
+    bool steers() const { return this->steers_; }
+
+    /**
+     * @brief Bytes held by the columns, padding and spare capacity
+     * included
+     */
+    size_t allocated_bytes() const;
+
+    /**
+     * @brief Call func on every column the store holds, in a fixed
+     * order: the float columns, alive, then the steering columns and
+     * target of homing stores
+     */
+    template<typename Func> void for_each_column(Func&& func)
+    {
+      visit_columns(*this, func);
+    }
+
+    template<typename Func> void for_each_column(Func&& func) const
+    {
+      visit_columns(*this, func);
+    }
+
+    /**
+     * @brief Raw view over the live objects, padded to whole lanes
+     */
+    KinematicsView view();
+
+    /**
+     * @brief Raw view over the objects in [begin, end). begin must be a
+     * multiple of lanes so the kernels stay aligned and never touch the
+     * lanes of a neighbouring range.
+     */
+    KinematicsView view(size_t begin, size_t end);
+
+  private:
+    size_t count_ = 0;
+    bool steers_;
+
+    // Grow every column to the given padded size
+    void resize(size_t padded);
+
+    // Float columns of every store
+    std::array<std::vector<float>*, 9> columns()
+    {
+      return {&px, &py, &ox, &oy, &vx, &vy, &dx, &dy, &life};
+    }
+
+    // Float columns of homing stores
+    std::array<std::vector<float>*, 3> steering()
+    {
+      return {&tx, &ty, &homing};
+    }
+
+    template<typename Self, typename Func>
+    static void visit_columns(Self& self, Func& func)
+    {
+      for (auto* column : {&self.px, &self.py, &self.ox, &self.oy,
+                           &self.vx, &self.vy, &self.dx, &self.dy,
+                           &self.life}) {
+        func(*column);
+      }
+      func(self.alive);
+      if (self.steers_) {
+        func(self.tx);
+        func(self.ty);
+        func(self.homing);
+        func(self.target);
+      }
+    }
+  };
+
+  // Straight bullets fit half a cache line of hot state
+  static_assert(Kinematics::footprint(Motion::Straight).hot <= 32);
+
+  /**
+   * @brief Best instruction set supported by the running CPU
+   */
+  SimdLevel detect_simd();
+
+  /**
+   * @brief Name of the instruction set
+   */
+  char const* simd_name(SimdLevel level);
+
+  /**
+   * @brief Integrate every object by one step: homing acceleration,
+   * Euler step, heading, lifetime countdown and bounds check. Straight
+   * motion skips the homing and heading work, and a straight store
+   * always moves straight.
+   */
+  void integrate(
+    Kinematics& kin,
+    StepParams const& params,
+    Motion motion,
+    SimdLevel level
+  );
+
+  void
+  integrate(Kinematics& kin, StepParams const& params, Motion motion);
+
+  /**
+   * @brief Integrate the objects in [begin, end) only, so disjoint
+   * ranges of a store can run on different threads
+   */
+  void integrate(
+    Kinematics& kin,
+    StepParams const& params,
+    Motion motion,
+    size_t begin,
+    size_t end
+  );
+}  //namespace kalika::internal
+
+#endif
@@ -9,6 +9,7 @@
 #include <format>
 
 #include <Event/GameEvent.hpp>
+#include <Object/Animation.hpp>
 #include <Object/Behaviour.hpp>
 #include <Object/helpers.hpp>
 
@@ -23,7 +24,7 @@ namespace kalika::internal
       sf::Vector2f position,
       sf::Vector2f velocity,
       sf::Vector2f dir,
-      sf::Texture& sprite_tex,
+      SpriteId sprite_id,
       float obj_size,
       EventBus* bus
     );
@@ -76,6 +77,32 @@ namespace kalika::internal
      */
     bool is_alive() const { return this->alive_; }
 
+    /**
+     * @brief Write a transform to the sprite. Unchanged transforms are
+     * skipped.
+     */
+    void sync_sprite(sf::Vector2f position, sf::Vector2f dir)
+    {
+      this->draw_.sync(position, dir);
+    }
+
+    /**
+     * @brief Join the clock's group for the object's cadence, in step
+     * with the objects already in it
+     */
+    void join(AnimationClock& clock);
+
+    /**
+     * @brief Show the group's frame if it changed on the last step
+     */
+    void animate(AnimationClock const& clock)
+    {
+      if (this->anim_group_ != no_anim_group &&
+          clock.changed(this->anim_group_)) {
+        this->draw_.set_frame(clock.frame(this->anim_group_));
+      }
+    }
+
   protected:
     // Event bus for pushing eventsscale
     EventBus* bus_;
@@ -88,13 +115,13 @@ namespace kalika::internal
     bool alive_ = true;
 
     // Animation variables
-    size_t fx, fy;
     bool animate_ = false;
     unsigned int frame_count_ = 2UL;
     unsigned int interval_ = 10UL;
+    AnimGroup anim_group_ = no_anim_group;
 
     // Behaviour variable
-    Behaviour behaviour_;
+    BehaviourId behaviour_ = no_behaviour;
 
     // ====== Helper functions ====== //
     /**
@@ -102,26 +129,12 @@ namespace kalika::internal
      */
     void update_frame();
 
-    /**
-     * @brief Animates the object
-     */
-    void animate(GameContext const& ctx);
-
     /**
      * @brief Returns true if the object is at the edge of the arena
      */
     bool at_edge(sf::FloatRect bounds)
     {
-      return bounds.contains(this->sprite().getPosition());
-    }
-
-  private:
-    template<typename T>
-    void set_frame(sf::Vector2<T> start, sf::Vector2<T> end)
-    {
-      auto m_start = sf::Vector2<int>(start);
-      auto m_end = sf::Vector2<int>(end);
-      this->sprite().setTextureRect({m_start, m_end});
+      return bounds.contains(this->position());
     }
   };
 }  //namespace kalika::internal
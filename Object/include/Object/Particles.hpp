@@ -0,0 +1,224 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Object/Kinematics.hpp>
+#include <Resource/Sprites.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Kinds of particle effect, one store each
+   */
+  enum class ParticleKind : std::uint8_t {
+    // Sparks thrown off by a bullet hitting an enemy
+    Spark,
+    // Debris of a destroyed enemy
+    Debris,
+    Count
+  };
+
+  inline constexpr size_t particle_kinds =
+    static_cast<size_t>(ParticleKind::Count);
+
+  /**
+   * @brief Look and motion shared by every particle of a kind
+   */
+  struct ParticleStyle {
+    SpriteId sprite;
+    sf::Color colour;
+    // Side of the quad at full strength, in pixels
+    float size;
+    // Launch speed and lifetime are picked in these ranges
+    float min_speed;
+    float max_speed;
+    float min_life;
+    float max_life;
+    // Fraction of the velocity lost per second
+    float drag;
+    // Particles per unit of burst strength
+    float per_unit;
+  };
+
+  // Styles indexed by ParticleKind
+  inline constexpr std::array<ParticleStyle, particle_kinds>
+    particle_styles{{
+      {
+        .sprite = SpriteId::Bullet,
+        .colour = sf::Color(255, 220, 120),
+        .size = 6.F,
+        .min_speed = 120.F,
+        .max_speed = 420.F,
+        .min_life = 0.15F,
+        .max_life = 0.35F,
+        .drag = 4.F,
+        .per_unit = 8.F,
+      },
+      {
+        .sprite = SpriteId::Bullet,
+        .colour = sf::Color(255, 140, 60),
+        .size = 10.F,
+        .min_speed = 60.F,
+        .max_speed = 300.F,
+        .min_life = 0.4F,
+        .max_life = 0.9F,
+        .drag = 2.F,
+        .per_unit = 0.5F,
+      },
+    }};
+
+  constexpr ParticleStyle const& style(ParticleKind kind)
+  {
+    return particle_styles[static_cast<size_t>(kind)];
+  }
+
+  /**
+   * @brief Particles thrown from one point at once
+   */
+  struct ParticleBurst {
+    sf::Vector2f position;
+    // Added to every particle, so debris keeps the enemy's momentum
+    sf::Vector2f velocity;
+    // Scales the particle count of the style: damage for sparks, size
+    // for debris
+    float strength;
+    ParticleKind kind;
+  };
+
+  namespace internal
+  {
+    /**
+     * @brief Per-tick inputs of the particle kernel
+     */
+    struct ParticleParams {
+      float dt;
+      // Velocity scale for this step, from the drag
+      float damp;
+    };
+
+    /**
+     * @brief Raw column pointers handed to the particle kernels
+     */
+    struct ParticleView {
+      float* px;
+      float* py;
+      float* vx;
+      float* vy;
+      float* life;
+      float const* inv_lifetime;
+      float* fade;
+      // Number of lanes, padded to a multiple of Kinematics::lanes
+      size_t count;
+    };
+
+    /**
+     * @brief Move, slow down and fade every lane by one step
+     */
+    void step_particles(
+      ParticleView const& view,
+      ParticleParams const& params,
+      SimdLevel level
+    );
+  }  //namespace internal
+
+  /**
+   * @brief Columns of one kind of particle, for the renderer
+   */
+  struct ParticleColumns {
+    ParticleStyle const& style;
+    std::span<float const> x;
+    std::span<float const> y;
+    // 1 at spawn down to 0 at the end of the particle's life
+    std::span<float const> fade;
+  };
+
+  /**
+   * @brief Short-lived effect particles, one SoA store per kind
+   *
+   * Every store is allocated up front at a fixed capacity; bursts past
+   * it are cut short rather than growing the store, so spawning never
+   * allocates. Particles are pure decoration: nothing reads them back,
+   * and they are left out of snapshots and digests.
+   */
+  struct ParticleSystem {
+    // Constructor. Capacity is per kind.
+    explicit ParticleSystem(size_t capacity = 1UL << 16U);
+
+    /**
+     * @brief Spawn a batch of bursts. Returns the number of particles
+     * spawned.
+     */
+    size_t emit(std::span<ParticleBurst const> bursts);
+
+    /**
+     * @brief Advance every particle by dt and drop the expired ones
+     */
+    void update(float dt);
+
+    void update(float dt, internal::SimdLevel level);
+
+    /**
+     * @brief Drop every particle
+     */
+    void clear();
+
+    /**
+     * @brief Columns of the live particles of a kind
+     */
+    ParticleColumns columns(ParticleKind kind) const;
+
+    /**
+     * @brief Live particles over every kind
+     */
+    size_t size() const;
+
+    size_t size(ParticleKind kind) const;
+
+    size_t capacity() const { return this->capacity_; }
+
+    /**
+     * @brief Particles cut from bursts since the start, for lack of room
+     */
+    size_t dropped() const { return this->dropped_; }
+
+    /**
+     * @brief Bytes every particle spends, all of it streamed per step
+     */
+    static constexpr size_t particle_bytes = 7 * sizeof(float);
+
+    /**
+     * @brief Bytes held by the columns of every kind
+     */
+    size_t allocated_bytes() const;
+
+  private:
+    /**
+     * @brief Columns of one kind
+     */
+    struct Store {
+      std::vector<float> px, py, vx, vy;
+      std::vector<float> life, inv_lifetime, fade;
+      size_t count = 0;
+
+      internal::ParticleView view();
+    };
+
+    size_t capacity_;
+    std::array<Store, particle_kinds> stores_;
+    size_t dropped_ = 0;
+    // Seeds the launch directions, speeds and lifetimes
+    std::uint32_t rng_ = 0x9e3779b9U;
+
+    // Next random number in [0, 1)
+    float random();
+  };
+}  //namespace kalika
+
+#endif
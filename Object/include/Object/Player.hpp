@@ -1,7 +1,9 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <memory>
@@ -18,12 +20,6 @@
 
 namespace kalika
 {
-  namespace internal
-  {
-    // Texture cache
-    sf::Texture& bullet_texture();
-  }  //namespace internal
-
   // Player Info
   struct PlayerInfo {
     // Phase of the player
@@ -32,9 +28,9 @@ namespace kalika
     // Facing direction of the player
     sf::Vector2f dir;
 
-    // Texture object
-    sf::Texture& player_tex;
-    sf::Texture& reticle_tex;
+    // Sprites in the atlas
+    SpriteId player_sprite;
+    SpriteId reticle_sprite;
 
     // Size of the object
     float size = 72.F;
@@ -44,6 +40,17 @@ namespace kalika
     float responsiveness;
   };
 
+  /**
+   * @brief Timers of a fire mode as plain fields, for snapshots
+   */
+  struct FireTimers {
+    float elapsed;
+    std::uint8_t spawn;
+    // Side of the next chaser bullet, unused by other modes
+    std::uint8_t toggle;
+    std::array<std::uint8_t, 2> reserved;
+  };
+
   /**
    * @brief Class describing Firing mode
    */
@@ -58,6 +65,28 @@ namespace kalika
     bool spawn = true;
     float elapsed = 0.F;
 
+    /**
+     * @brief Copy of the timers
+     */
+    FireTimers timers() const
+    {
+      return {
+        .elapsed = this->elapsed,
+        .spawn = this->spawn ? std::uint8_t{1} : std::uint8_t{0},
+        .toggle = 0,
+        .reserved = {},
+      };
+    }
+
+    /**
+     * @brief Take over timers saved by timers()
+     */
+    void restore(FireTimers const& saved)
+    {
+      this->elapsed = saved.elapsed;
+      this->spawn = saved.spawn != 0;
+    }
+
   protected:
     /**
      * @brief Sets spawn to true based on fire rate
@@ -111,7 +140,9 @@ namespace kalika
     void fire(GameContext const& ctx, float dt, EventBus* bus);
 
   private:
-    static constexpr size_t count = 5;
+    static constexpr std::uint32_t count = 5;
+    // Half the angle of the fan in degrees
+    static constexpr float arc = 30.F;
   };
 
   /**
@@ -130,11 +161,50 @@ namespace kalika
      */
     void fire(GameContext const& ctx, float dt, EventBus* bus);
 
+    // Timers with the side of the next bullet
+    FireTimers timers() const
+    {
+      auto saved = FireMode::timers();
+      saved.toggle = this->toggle_ ? std::uint8_t{1} : std::uint8_t{0};
+      return saved;
+    }
+
+    void restore(FireTimers const& saved)
+    {
+      FireMode::restore(saved);
+      this->toggle_ = saved.toggle != 0;
+    }
+
   private:
     static constexpr size_t count = 1;
     bool toggle_ = true;
   };
 
+  // Fire modes the player switches between
+  using FireType = std::variant<RapidFire, SpreadFire, ChaserFire>;
+
+  /**
+   * @brief Simulation state of the player as one flat record, for
+   * snapshots. The sprites catch up on the next render sync.
+   */
+  struct PlayerState {
+    internal::Movable mov;
+    // Stick positions
+    sf::Vector2f strength;
+    sf::Vector2f aim;
+    // Reticle
+    sf::Vector2f offset;
+    float reticle_elapsed;
+    bool active;
+    // State before the last tick, for render interpolation
+    sf::Vector2f prev_pos;
+    sf::Vector2f prev_offset;
+    // Fire mode, and the timers of every mode in FireType order
+    size_t mode;
+    std::array<FireTimers, std::variant_size_v<FireType>> fire_timers;
+  };
+  static_assert(std::is_trivially_copyable_v<PlayerState>);
+
   /**
    * @brief Player class
    */
@@ -159,7 +229,9 @@ namespace kalika
       float elapsed = duration;
 
       // Constructer
-      Reticle(sf::Texture& texture) : sprite(texture) {}
+      Reticle(SpriteId id) :
+        sprite(atlas().texture(id), atlas().region(id).frame(0))
+      {}
 
       bool update_timer(float dt)
       {
@@ -170,6 +242,9 @@ namespace kalika
       void reset_timer() { this->elapsed = this->duration; }
     };
 
+    // Number of fire modes
+    static constexpr size_t NUM_MODES = std::variant_size_v<FireType>;
+
     // Reticle object associated with player
     Reticle shoot;
 
@@ -189,6 +264,12 @@ namespace kalika
      */
     void update(GameContext const& ctx, float dt);
 
+    /**
+     * @brief Write the ship and reticle state to their sprites,
+     * interpolated by alpha between the previous and current tick
+     */
+    void sync_render(float alpha = 1.F);
+
     void set_strength(sf::Vector2f l_strength, sf::Vector2f r_strength)
     {
       this->strength = l_strength;
@@ -202,14 +283,30 @@ namespace kalika
     {
       std::visit(
         [&](auto& arg) { arg.fire(ctx, dt, this->bus_); },
-        fire_modes_[this->mode_id_]
+        this->fire_modes_[this->mode_id_]
       );
     }
 
     /**
-     * @brief Set the fire mode
+     * @brief Set the fire mode. Ids past the last mode are ignored.
+     */
+    void set_mode(size_t idx)
+    {
+      if (idx < NUM_MODES) {
+        this->mode_id_ = idx;
+      }
+    }
+
+    /**
+     * @brief Flat copy of the simulation state
      */
-    void set_mode(size_t idx) { this->mode_id_ = idx; }
+    PlayerState state() const;
+
+    /**
+     * @brief Take over a state saved by state(). The mode must be in
+     * range; World::read_snapshot checks it.
+     */
+    void restore(PlayerState const& state);
 
     // Remove the move method for player. Use update instead
     void move(
@@ -223,12 +320,13 @@ namespace kalika
     // Set if reticle should be active
     bool active_ = false;
 
-    // Choose a firing mode
-    using FireType = std::variant<RapidFire, SpreadFire, ChaserFire>;
-    static constexpr size_t NUM_MODES = std::variant_size_v<FireType>;
-    inline static std::array<FireType, NUM_MODES> fire_modes_{
-      RapidFire(), SpreadFire(), ChaserFire()
-    };
+    // State before the last tick, for render interpolation
+    sf::Vector2f prev_pos_;
+    sf::Vector2f prev_offset_;
+
+    // Choose a firing mode. Every player keeps its own timers, so
+    // simulations in one process never share them.
+    std::array<FireType, NUM_MODES> fire_modes_;
     size_t mode_id_ = 0;
 
     // ====== Helper Functions ======= //
@@ -1,98 +1,405 @@
 #ifndef POOL_H
 #define POOL_H
 
-#include <deque>
+#include <algorithm>
+#include <cstdint>
 #include <limits>
+#include <span>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
-// Wrapper around the object
+// Index types used by the pool
 using slot_id = std::size_t;
+using generation_t = std::uint32_t;
 constexpr size_t npos = std::numeric_limits<std::size_t>::max();
 
 /**
- * @brief Wrapper around an object class
+ * @brief Generational handle to an object owned by a pool
  */
-template<typename Object> struct Wrapper {
-  Object obj;
-  slot_id idx;
-  slot_id next_free = npos;
-  bool occupied = false;
+struct Handle {
+  slot_id idx = npos;
+  generation_t gen = 0;
 
-  // Constructor
-  template<typename... Args>
-  Wrapper(Args&&... args) : obj(std::forward<Args>(args)...)
-  {}
-
-  // Operator overloading
-  Object* operator->() { return &(this->obj); }
-
-  Object const* operator->() const { return &(this->obj); }
+  bool operator==(Handle const&) const = default;
 };
 
 /**
  * @brief Generic Pool
+ *
+ * Sparse set of objects. Live objects are packed at the front of a dense
+ * array and removed by swapping with the last live object. Handles index
+ * a sparse array that maps them to their dense slot, and carry a
+ * generation so that stale handles are rejected once a slot is reused.
+ * Dead objects past the live range are kept around and rebuilt on the
+ * next acquire.
  */
 template<typename Object> struct Pool {
+  using iterator = typename std::vector<Object>::iterator;
+  using const_iterator = typename std::vector<Object>::const_iterator;
+
   /**
-   * @brief Acquire the index of the object
+   * @brief Sparse entry pointing at a dense slot
    */
-  template<typename... Args> Wrapper<Object>& acquire(Args&&... args)
+  struct Sparse {
+    slot_id dense = npos;
+    slot_id next_free = npos;
+    generation_t gen = 0;
+    // Explicit padding, so snapshots copy the entries as they are
+    generation_t reserved = 0;
+  };
+  static_assert(std::has_unique_object_representations_v<Sparse>);
+
+  /**
+   * @brief Acquire an object and return its handle
+   */
+  template<typename... Args> Handle acquire(Args&&... args)
   {
-    // Pool is fill. Add a new object
-    if (this->free_head_ == npos) {
-      Wrapper<Object>& slot =
-        this->slots_.emplace_back(std::forward<Args>(args)...);
+    // Grab a sparse entry from the free list
+    slot_id idx = this->free_head_;
+    if (idx == npos) {
+      idx = this->sparse_.size();
+      this->sparse_.emplace_back();
+    }
+    else {
+      this->free_head_ = this->sparse_[idx].next_free;
+    }
 
-      slot.idx = this->capacity() - 1;
-      slot.occupied = true;
-      return slot;
+    // Construct a new object or rebuild a recycled one
+    slot_id const dense = this->count_;
+    if (dense == this->objects_.size()) {
+      this->objects_.emplace_back(std::forward<Args>(args)...);
+      this->owners_.push_back(idx);
     }
-    // Get the object at the free head
-    slot_id idx = this->free_head_;
-    Wrapper<Object>& slot = this->slots_[idx];
+    else {
+      this->objects_[dense].rebuild(std::forward<Args>(args)...);
+      this->owners_[dense] = idx;
+    }
+    this->count_++;
+
+    Sparse& entry = this->sparse_[idx];
+    entry.dense = dense;
+    entry.next_free = npos;
+
+    return {idx, entry.gen};
+  }
 
-    // Rebuild its state
-    slot->rebuild(std::forward<Args>(args)...);
-    slot.occupied = true;
-    this->free_head_ = slot.next_free;
+  /**
+   * @brief Acquire one object per element of args, each built from its
+   * element followed by the shared arguments. Storage grows once for the
+   * whole batch. The new objects take the dense slots [first, size()),
+   * and first is returned.
+   */
+  template<typename Arg, typename... Shared>
+  slot_id acquire_bulk(std::span<Arg const> args, Shared const&... shared)
+  {
+    slot_id const first = this->count_;
+    size_t const total = first + args.size();
+    size_t const fresh = (total > this->objects_.size())
+                           ? total - this->objects_.size()
+                           : 0UL;
+    grow(this->objects_, total);
+    grow(this->sparse_, this->sparse_.size() + fresh);
+    if (total > this->owners_.size()) {
+      this->owners_.resize(total);
+    }
 
-    slot.next_free = npos;
+    for (size_t i = 0; i < args.size(); i++) {
+      // Grab a sparse entry from the free list
+      slot_id idx = this->free_head_;
+      if (idx == npos) {
+        idx = this->sparse_.size();
+        this->sparse_.emplace_back();
+      }
+      else {
+        this->free_head_ = this->sparse_[idx].next_free;
+      }
 
-    return slot;
+      // Construct a new object or rebuild a recycled one
+      slot_id const dense = first + i;
+      if (dense == this->objects_.size()) {
+        this->objects_.emplace_back(args[i], shared...);
+      }
+      else {
+        this->objects_[dense].rebuild(args[i], shared...);
+      }
+      this->owners_[dense] = idx;
+
+      Sparse& entry = this->sparse_[idx];
+      entry.dense = dense;
+      entry.next_free = npos;
+    }
+    this->count_ = total;
+
+    return first;
   }
 
   /**
-   * @brief Release the object for re-use
+   * @brief Release the object for re-use. Returns false for stale handles
    */
-  void release(slot_id idx)
+  bool release(Handle handle)
   {
-    // Check if index is valid
-    if (!valid(idx)) {
-      return;
+    slot_id const dense = this->dense_index(handle);
+    if (dense == npos) {
+      return false;
     }
 
-    Wrapper<Object>& slot = this->slots_[idx];
-    // Set the slot to free
-    slot.occupied = false;
-    slot.next_free = free_head_;
+    this->release_at(dense);
+    return true;
+  }
 
-    // Set the free head to current
+  /**
+   * @brief Release the object in a dense slot. The last live object is
+   * moved into the freed slot.
+   */
+  void release_at(slot_id dense)
+  {
+    slot_id const last = this->count_ - 1;
+    slot_id const idx = this->owners_[dense];
+
+    // Move the last live object into the hole
+    if (dense != last) {
+      std::swap(this->objects_[dense], this->objects_[last]);
+      std::swap(this->owners_[dense], this->owners_[last]);
+      this->sparse_[this->owners_[dense]].dense = dense;
+    }
+    this->count_--;
+
+    // Invalidate outstanding handles and push to the free list
+    Sparse& entry = this->sparse_[idx];
+    entry.dense = npos;
+    entry.gen++;
+    entry.next_free = this->free_head_;
     this->free_head_ = idx;
   }
 
+  /**
+   * @brief Release every live object matching the predicate
+   */
+  template<typename Pred> size_t release_if(Pred pred)
+  {
+    size_t released = 0;
+    for (slot_id dense = 0; dense < this->count_;) {
+      if (pred(this->objects_[dense])) {
+        this->release_at(dense);
+        released++;
+      }
+      else {
+        dense++;
+      }
+    }
+    return released;
+  }
+
+  /**
+   * @brief Return the object the handle refers to, or nullptr if stale
+   */
+  Object* get(Handle handle)
+  {
+    slot_id const dense = this->dense_index(handle);
+    return (dense == npos) ? nullptr : &this->objects_[dense];
+  }
+
+  Object const* get(Handle handle) const
+  {
+    slot_id const dense = this->dense_index(handle);
+    return (dense == npos) ? nullptr : &this->objects_[dense];
+  }
+
+  /**
+   * @brief Check if the handle refers to a live object
+   */
+  bool valid(Handle handle) const
+  {
+    return this->dense_index(handle) != npos;
+  }
+
+  /**
+   * @brief Dense slot of the object, or npos if the handle is stale
+   */
+  slot_id dense_index(Handle handle) const
+  {
+    if (handle.idx >= this->sparse_.size()) {
+      return npos;
+    }
+    Sparse const& entry = this->sparse_[handle.idx];
+    return (entry.gen == handle.gen) ? entry.dense : npos;
+  }
+
+  /**
+   * @brief Handle of the object in a dense slot
+   */
+  Handle handle(slot_id dense) const
+  {
+    slot_id const idx = this->owners_[dense];
+    return {idx, this->sparse_[idx].gen};
+  }
+
+  /**
+   * @brief Reserve memory for a number of objects
+   */
+  void reserve(size_t count)
+  {
+    this->objects_.reserve(count);
+    this->owners_.reserve(count);
+    this->sparse_.reserve(count);
+  }
+
+  /**
+   * @brief Construct dead objects up front until the pool holds count,
+   * so later acquires up to that size only rebuild and never allocate
+   */
+  template<typename... Args>
+  void prewarm(size_t count, Args const&... args)
+  {
+    this->reserve(count);
+    while (this->objects_.size() < count) {
+      this->objects_.emplace_back(args...);
+      this->owners_.push_back(npos);
+    }
+  }
+
+  // Access live objects by dense slot
+  Object& operator[](slot_id dense) { return this->objects_[dense]; }
+
+  Object const& operator[](slot_id dense) const
+  {
+    return this->objects_[dense];
+  }
+
+  // Iterate over the live objects
+  iterator begin() { return this->objects_.begin(); }
+
+  iterator end() { return this->objects_.begin() + this->count_; }
+
+  const_iterator begin() const { return this->objects_.begin(); }
+
+  const_iterator end() const
+  {
+    return this->objects_.begin() + this->count_;
+  }
+
+  /**
+   * @brief Number of live objects
+   */
+  size_t size() const { return this->count_; }
+
   /**
    * @brief Capacity of the pool
    */
-  slot_id capacity() const { return this->slots_.size(); }
+  slot_id capacity() const { return this->objects_.size(); }
+
+  /**
+   * @brief Bytes held by the pool's arrays, spare capacity included.
+   * Memory the objects allocate themselves is not counted.
+   */
+  size_t allocated_bytes() const
+  {
+    return (this->objects_.capacity() * sizeof(Object)) +
+           (this->owners_.capacity() * sizeof(slot_id)) +
+           (this->sparse_.capacity() * sizeof(Sparse));
+  }
+
+  /**
+   * @brief Sparse entry owning each live dense slot
+   */
+  std::span<slot_id const> owners() const
+  {
+    return {this->owners_.data(), this->count_};
+  }
+
+  /**
+   * @brief Every sparse entry, live or free
+   */
+  std::span<Sparse const> entries() const { return this->sparse_; }
+
+  /**
+   * @brief First sparse entry of the free list
+   */
+  slot_id free_head() const { return this->free_head_; }
+
+  /**
+   * @brief Rebuild the pool from the owners(), entries() and free_head()
+   * of another, with live object i built from args[i] and the shared
+   * arguments. The other pool's handles stay valid; its dead objects
+   * are not brought back. Returns false, leaving the pool untouched, if
+   * the bookkeeping does not add up.
+   */
+  template<typename Arg, typename... Shared>
+  bool restore(
+    std::span<Arg const> args,
+    std::span<slot_id const> owners,
+    std::span<Sparse const> entries,
+    slot_id free_head,
+    Shared const&... shared
+  )
+  {
+    // Every live object is owned by an entry pointing back at it
+    if (owners.size() != args.size()) {
+      return false;
+    }
+    for (slot_id dense = 0; dense < owners.size(); dense++) {
+      if (owners[dense] >= entries.size() ||
+          entries[owners[dense]].dense != dense) {
+        return false;
+      }
+    }
+    // ... and every live entry is the owner of its dense slot
+    for (slot_id idx = 0; idx < entries.size(); idx++) {
+      auto const dense = entries[idx].dense;
+      if (dense != npos &&
+          (dense >= args.size() || owners[dense] != idx)) {
+        return false;
+      }
+    }
+    // The free list stays inside the entries, holds only free ones and
+    // ends
+    size_t steps = 0;
+    for (slot_id idx = free_head; idx != npos;
+         idx = entries[idx].next_free) {
+      if (idx >= entries.size() || entries[idx].dense != npos ||
+          ++steps > entries.size()) {
+        return false;
+      }
+    }
+
+    this->objects_.clear();
+    this->objects_.reserve(args.size());
+    for (auto const& arg : args) {
+      this->objects_.emplace_back(arg, shared...);
+    }
+    this->owners_.assign(owners.begin(), owners.end());
+    this->sparse_.assign(entries.begin(), entries.end());
+    this->free_head_ = free_head;
+    this->count_ = args.size();
+    return true;
+  }
+
+  /**
+   * @brief Bookkeeping bytes per slot, on top of the object itself
+   */
+  static constexpr size_t slot_overhead()
+  {
+    return sizeof(slot_id) + sizeof(Sparse);
+  }
 
 private:
+  // Dense array of objects. [0, count_) are live
+  std::vector<Object> objects_;
+  // Sparse entry owning each dense slot
+  std::vector<slot_id> owners_;
+  // Handle lookup
+  std::vector<Sparse> sparse_;
+
   slot_id free_head_ = npos;
-  std::deque<Wrapper<Object>> slots_;
+  size_t count_ = 0;
 
-  // ======= Helper functions ======= //
-  bool valid(slot_id idx) const
+  // Make room for size elements, keeping geometric growth
+  template<typename T> static void grow(std::vector<T>& vec, size_t size)
   {
-    return idx < this->slots_.size() && slots_[idx].occupied;
+    if (size > vec.capacity()) {
+      vec.reserve(std::max(size, 2 * vec.capacity()));
+    }
   }
 };
 
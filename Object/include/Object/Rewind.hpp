@@ -0,0 +1,109 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include <Object/Snapshot.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Bounded history of recent snapshots, one per tick
+   *
+   * Every keyframe_interval ticks the whole snapshot is kept. The ticks
+   * in between keep a delta against the tick before: for each section,
+   * the runs of bytes that changed. Bullets that did not move, enemies
+   * that were not hit and player fields that stayed put cost nothing.
+   * Stepping back to a tick replays at most one keyframe interval of
+   * deltas.
+   *
+   * Once the history outgrows its budget the oldest keyframe and its
+   * deltas are dropped together, so memory stays within the budget plus
+   * one interval. The newest interval is always kept.
+   */
+  struct RewindBuffer {
+    // Constructor. The budget is in bytes.
+    explicit RewindBuffer(size_t budget, size_t keyframe_interval = 60UL);
+
+    /**
+     * @brief Add the snapshot taken at the end of a tick. A tick that
+     * does not follow the newest one starts a new keyframe.
+     *
+     * The buffer is taken over and swapped for one holding an older
+     * state, so the next snapshot can be written into it without
+     * allocating. Returns false, taking nothing, if the buffer does not
+     * hold a valid snapshot.
+     */
+    bool capture(std::uint64_t tick, std::vector<std::byte>& state);
+
+    /**
+     * @brief Rebuild the state of a tick, or nothing if it is not held
+     */
+    std::optional<SnapshotView> at(std::uint64_t tick) const;
+
+    /**
+     * @brief Forget every tick after this one, to branch off from it
+     */
+    void truncate(std::uint64_t tick);
+
+    void clear();
+
+    /**
+     * @brief Oldest and newest tick held. The history must not be
+     * empty.
+     */
+    std::uint64_t oldest() const { return this->entries_.front().tick; }
+
+    std::uint64_t newest() const { return this->entries_.back().tick; }
+
+    bool empty() const { return this->entries_.empty(); }
+
+    /**
+     * @brief Number of ticks held
+     */
+    size_t size() const { return this->entries_.size(); }
+
+    /**
+     * @brief Bytes of keyframes and deltas held
+     */
+    size_t bytes() const { return this->bytes_; }
+
+    size_t budget() const { return this->budget_; }
+
+    size_t keyframe_interval() const { return this->interval_; }
+
+  private:
+    /**
+     * @brief State of one tick, whole or as a delta
+     */
+    struct Entry {
+      std::uint64_t tick;
+      bool keyframe;
+      std::vector<std::byte> data;
+    };
+
+    size_t budget_;
+    size_t interval_;
+
+    // Ticks in order, oldest first
+    std::deque<Entry> entries_;
+    size_t bytes_ = 0;
+    // Newest state, for the next delta, or empty after a truncate
+    std::vector<std::byte> last_;
+    // Deltas since the newest keyframe
+    size_t since_keyframe_ = 0;
+    // Buffers of dropped entries, reused by later ones
+    std::vector<std::vector<std::byte>> spare_;
+
+    // Buffer for a new entry
+    std::vector<std::byte> take_buffer();
+    // Drop the oldest keyframe and its deltas while over budget
+    void evict();
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Snapshot elements have their padding zeroed, which needs the compiler
+// to say which bytes are padding. Without it, files and rewind deltas
+// would carry whatever was in memory.
+#ifdef __has_builtin
+  #if __has_builtin(__builtin_clear_padding)
+    #define KALIKA_CLEAR_PADDING
+  #endif
+#endif
+#ifndef KALIKA_CLEAR_PADDING
+  #error "Snapshots need a compiler with __builtin_clear_padding"
+#endif
+
+namespace kalika
+{
+  /**
+   * @brief Kinds of section in a snapshot. The index of a section tells
+   * sections of one kind apart.
+   */
+  enum class SnapshotSection : std::uint32_t {
+    // Tick counter and wave progress, index 0
+    Simulation,
+    // Events published and not yet delivered, indexed by event type
+    Events,
+    // Player state, index 0
+    Player,
+    // Kinematics column of a bullet partition, indexed by
+    // behaviour << 8 | column
+    BulletColumn,
+    // Sprite and size of every bullet of a partition, by behaviour
+    BulletLooks,
+    // Live enemies, index 0
+    Enemies,
+    // Handle bookkeeping of a pool: bullet partitions by behaviour, and
+    // behaviour_count for the enemies
+    PoolOwners,
+    PoolEntries,
+    PoolFreeHead,
+  };
+
+  /**
+   * @brief Fixed header at the start of a snapshot file
+   */
+  struct SnapshotHeader {
+    static constexpr std::uint32_t current_version = 1;
+    // Written in native order, so a file from another byte order fails
+    static constexpr std::uint32_t byte_order = 0x01020304U;
+
+    std::array<char, 8> magic = {'K', 'S', 'N', 'A', 'P', 'S', 'H', 'T'};
+    std::uint32_t version = current_version;
+    std::uint32_t order = byte_order;
+    std::uint32_t sections = 0;
+    std::uint32_t reserved = 0;
+    // Size of the whole file
+    std::uint64_t size = 0;
+  };
+
+  /**
+   * @brief Entry of the section table following the header
+   */
+  struct SnapshotEntry {
+    SnapshotSection kind;
+    std::uint32_t index;
+    // Size of one element, checked against the type it is read as
+    std::uint32_t elem_size;
+    std::uint32_t reserved;
+    // From the start of the file, aligned to snapshot_align
+    std::uint64_t offset;
+    std::uint64_t count;
+  };
+
+  // Alignment of every section in the file
+  inline constexpr size_t snapshot_align = 64;
+
+  /**
+   * @brief Builds a snapshot in memory, one flat array per section
+   *
+   * Sections hold trivially copyable elements only, laid out as they
+   * are in memory with their padding zeroed, so equal states give equal
+   * bytes. A snapshot is only read back by the build that wrote
+   * it; the header rejects other versions and byte orders, and every
+   * section checks its element size.
+   */
+  struct SnapshotWriter {
+    /**
+     * @brief Append a section
+     */
+    template<typename T>
+    void add(
+      SnapshotSection kind, std::uint32_t index, std::span<T const> items
+    )
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      auto const out = this->add_bytes(
+        kind,
+        index,
+        sizeof(T),
+        items.size(),
+        std::as_bytes(items)
+      );
+      if constexpr (!std::has_unique_object_representations_v<T>) {
+        clear_padding(reinterpret_cast<T*>(out.data()), items.size());
+      }
+    }
+
+    template<typename T>
+    void add(SnapshotSection kind, std::uint32_t index, T const& item)
+    {
+      this->add(kind, index, std::span<T const>(&item, 1));
+    }
+
+    /**
+     * @brief Append a section from raw bytes holding count elements of
+     * elem_size bytes. Returns where the bytes were copied to.
+     */
+    std::span<std::byte> add_bytes(
+      SnapshotSection kind,
+      std::uint32_t index,
+      size_t elem_size,
+      size_t count,
+      std::span<std::byte const> data
+    );
+
+    /**
+     * @brief Drop every section, keeping the buffers
+     */
+    void clear();
+
+    /**
+     * @brief The whole file: header, section table and payload
+     */
+    std::vector<std::byte> bytes() const;
+
+    /**
+     * @brief Lay the file out into a buffer, reusing its storage
+     */
+    void bytes(std::vector<std::byte>& file) const;
+
+    /**
+     * @brief Write the file
+     */
+    bool save(char const* path) const;
+
+  private:
+    std::vector<SnapshotEntry> entries_;
+    // Payload, with offsets relative to its start
+    std::vector<std::byte> payload_;
+
+    // Zero the padding bytes of elements copied into the payload, which
+    // would otherwise hold whatever was in memory
+    template<typename T> static void clear_padding(T* items, size_t count)
+    {
+      for (size_t i = 0; i < count; i++) {
+        __builtin_clear_padding(items + i);
+      }
+    }
+  };
+
+  /**
+   * @brief Read-only view of a snapshot, mapped from a file or held in
+   * memory
+   *
+   * Sections are handed out as spans straight into the mapping, so
+   * restoring a column is a single bulk copy with nothing to parse.
+   */
+  struct SnapshotView {
+    /**
+     * @brief Map a snapshot file. Fails on a missing file or a bad
+     * header or section table.
+     */
+    static std::optional<SnapshotView> open(char const* path);
+
+    /**
+     * @brief View a snapshot held in memory. Sections are only aligned
+     * as far as the vector's storage is, which is enough for any
+     * element type.
+     */
+    static std::optional<SnapshotView>
+    from_bytes(std::vector<std::byte> bytes);
+
+    /**
+     * @brief View bytes owned by the caller, who keeps them alive and
+     * unchanged for as long as the view or a copy of it is used
+     */
+    static std::optional<SnapshotView>
+    borrow(std::span<std::byte const> bytes);
+
+    /**
+     * @brief Elements of a section, or nothing if it is missing or was
+     * written with another element size
+     */
+    template<typename T>
+    std::optional<std::span<T const>>
+    section(SnapshotSection kind, std::uint32_t index) const
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      auto const* entry = this->find(kind, index);
+      if (entry == nullptr || entry->elem_size != sizeof(T)) {
+        return std::nullopt;
+      }
+      auto const* first = reinterpret_cast<T const*>(
+        this->data() + entry->offset
+      );
+      return std::span<T const>(first, entry->count);
+    }
+
+    /**
+     * @brief The single element of a section, or nullptr
+     */
+    template<typename T>
+    T const* single(SnapshotSection kind, std::uint32_t index) const
+    {
+      auto const items = this->section<T>(kind, index);
+      return (items && items->size() == 1) ? items->data() : nullptr;
+    }
+
+    /**
+     * @brief Size of the snapshot in bytes
+     */
+    size_t size() const;
+
+    /**
+     * @brief The whole file
+     */
+    std::span<std::byte const> bytes() const
+    {
+      return {this->data(), this->size()};
+    }
+
+    /**
+     * @brief Section table, in the order the sections were added
+     */
+    std::span<SnapshotEntry const> entries() const;
+
+    /**
+     * @brief Table entry of a section, or nullptr if it is missing
+     */
+    SnapshotEntry const*
+    find(SnapshotSection kind, std::uint32_t index) const;
+
+    /**
+     * @brief Raw bytes of a section of this snapshot
+     */
+    std::span<std::byte const> bytes(SnapshotEntry const& entry) const
+    {
+      return {
+        this->data() + entry.offset, entry.count * entry.elem_size
+      };
+    }
+
+  private:
+    // Mapped file or owned bytes
+    struct Storage;
+    std::shared_ptr<Storage const> storage_;
+
+    explicit SnapshotView(std::shared_ptr<Storage const> storage) :
+      storage_(std::move(storage))
+    {}
+
+    std::byte const* data() const;
+
+    // Check the header and that every section lies inside the file
+    static std::optional<SnapshotView>
+    validate(std::shared_ptr<Storage const> storage);
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,150 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Uniform grid over the world, bucketing circles by cell
+   *
+   * Rebuilt from scratch every tick with a counting sort: one pass counts
+   * the circles per cell, a prefix sum gives each cell its range and a
+   * second pass scatters the circles. A circle goes in every cell its
+   * bounding square overlaps, so a point only needs to look at its own
+   * cell. Circles of a cell are contiguous and keep their input order.
+   * Anything outside the bounds is clamped into the border cells.
+   */
+  struct SpatialGrid {
+    /**
+     * @brief A circle as stored in a cell
+     */
+    struct Entry {
+      float x;
+      float y;
+      float radius;
+      // Index of the circle in the input
+      std::uint32_t id;
+    };
+
+    // Most cells along either axis
+    static constexpr std::uint32_t max_axis_cells = 256;
+
+    /**
+     * @brief Cover the bounds with square cells of the given size, or
+     * larger ones when the bounds need more than max_axis_cells
+     */
+    void reset(sf::FloatRect bounds, float cell_size);
+
+    /**
+     * @brief Bucket the circles. Entry i of the grid is circle i.
+     */
+    void build(
+      std::span<float const> xs,
+      std::span<float const> ys,
+      std::span<float const> radii
+    );
+
+    /**
+     * @brief Call visit(entry) for every circle in the cell of the point,
+     * in input order
+     */
+    template<typename Visit>
+    void query_point(float x, float y, Visit&& visit) const
+    {
+      auto const [col, row] = this->cell_coords(x, y);
+      auto const cell = (row * this->cols_) + col;
+      auto const end = this->start_[cell + 1];
+      for (auto k = this->start_[cell]; k < end; k++) {
+        visit(this->entries_[k]);
+      }
+    }
+
+    /**
+     * @brief Call visit(entry) for every circle in the cells overlapping
+     * the square of half-size radius around (x, y). A circle spanning
+     * several of those cells is visited once per cell.
+     */
+    template<typename Visit>
+    void query(float x, float y, float radius, Visit&& visit) const
+    {
+      auto const [col0, row0] = this->cell_coords(x - radius, y - radius);
+      auto const [col1, row1] = this->cell_coords(x + radius, y + radius);
+      for (auto row = row0; row <= row1; row++) {
+        for (auto col = col0; col <= col1; col++) {
+          auto const cell = (row * this->cols_) + col;
+          auto const end = this->start_[cell + 1];
+          for (auto k = this->start_[cell]; k < end; k++) {
+            visit(this->entries_[k]);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Circle whose centre is closest to the point and at most
+     * radius away, or nullptr. Ties go to the lowest id.
+     *
+     * Searches rings of cells outwards from the point's cell and stops
+     * once no unvisited cell can hold anything closer.
+     */
+    Entry const* nearest(float x, float y, float radius) const;
+
+    /**
+     * @brief Number of circles in the grid
+     */
+    size_t size() const { return this->count_; }
+
+    bool empty() const { return this->count_ == 0; }
+
+    /**
+     * @brief Number of cells
+     */
+    size_t cell_count() const { return this->cols_ * this->rows_; }
+
+    float cell_size() const { return this->cell_size_; }
+
+  private:
+    // Grid placement
+    float left_ = 0.F;
+    float top_ = 0.F;
+    float cell_size_ = 1.F;
+    float inv_cell_ = 1.F;
+    std::uint32_t cols_ = 1;
+    std::uint32_t rows_ = 1;
+
+    // First entry of each cell, plus one past the last
+    std::vector<std::uint32_t> start_ = {0U, 0U};
+    // Entries sorted by cell
+    std::vector<Entry> entries_;
+    size_t count_ = 0;
+
+    struct Coords {
+      std::uint32_t col;
+      std::uint32_t row;
+    };
+
+    // Clamped cell of a position
+    Coords cell_coords(float x, float y) const
+    {
+      auto const clamp = [](float pos, std::uint32_t count) {
+        auto const cell = static_cast<std::int64_t>(pos);
+        return static_cast<std::uint32_t>(
+          std::clamp<std::int64_t>(cell, 0, count - 1)
+        );
+      };
+      return {
+        clamp((x - this->left_) * this->inv_cell_, this->cols_),
+        clamp((y - this->top_) * this->inv_cell_, this->rows_),
+      };
+    }
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef TARGETING_H
+#define TARGETING_H
+
+#include <cstddef>
+
+#include <Object/Collision.hpp>
+#include <Object/Kinematics.hpp>
+#include <Object/SpatialGrid.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Work done by a targeting pass
+   */
+  struct TargetStats {
+    // Bullets that kept last tick's target
+    size_t kept = 0;
+    // Grid searches run
+    size_t searched = 0;
+    // Searches that found an enemy
+    size_t found = 0;
+  };
+
+  // Ticks between searches of a bullet that found nothing
+  constexpr size_t retarget_interval = 4;
+
+  /**
+   * @brief Point every homing object at the nearest enemy in range and
+   * write the target positions for the kernel
+   *
+   * Objects keep their target across ticks while it lives and stays in
+   * range, so a search only runs when a target is lost. Objects that
+   * found nothing search again every few ticks, staggered by slot, so a
+   * screen without enemies around costs almost no searches. Untargeted
+   * objects aim at themselves, which does not steer.
+   */
+  TargetStats assign_targets(
+    internal::Kinematics& kin,
+    SpatialGrid const& grid,
+    Colliders const& enemies,
+    float range,
+    size_t tick
+  );
+
+  /**
+   * @brief Refresh the targets of the objects in [begin, end) only, so
+   * disjoint ranges can run on different threads
+   */
+  TargetStats assign_targets(
+    internal::Kinematics& kin,
+    SpatialGrid const& grid,
+    Colliders const& enemies,
+    float range,
+    size_t tick,
+    size_t begin,
+    size_t end
+  );
+}  //namespace kalika
+
+#endif
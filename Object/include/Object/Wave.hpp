@@ -0,0 +1,151 @@
+#ifndef WAVE_H
+#define WAVE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Event/GameEvent.hpp>
+#include <Object/Behaviour.hpp>
+
+namespace kalika
+{
+  // Wave played by the game
+  inline constexpr char const* default_wave =
+    "resources/waves/default.wave";
+
+  /**
+   * @brief One enemy of a wave
+   */
+  struct WaveSpawn {
+    // Seconds from the start of the wave
+    float time;
+    BehaviourId behaviour;
+    // Position as a fraction of the world bounds
+    float x;
+    float y;
+    // Velocity in pixels per second
+    float vx;
+    float vy;
+    float health;
+    // Seconds on the field, or negative to stay until killed
+    float lifetime;
+  };
+
+  /**
+   * @brief Enemies of a wave file, sorted by spawn time
+   *
+   * A wave file holds one group of enemies per line:
+   *
+   *     # time behaviour count every x    y    dx   dy vx vy  health life
+   *     0.5    dasher    12    0.25  0.05 0.10 0.08 0  0  250 10     -1
+   *
+   * Enemy i of a group spawns at time + i * every, at (x + i * dx,
+   * y + i * dy), in fractions of the world bounds. Times are in seconds,
+   * velocities in pixels per second, and a negative life keeps the
+   * enemy until it is killed. An "end <seconds>" line sets the length of
+   * the wave, which defaults to the last spawn. Blank lines and text
+   * after # are ignored.
+   */
+  struct Wave {
+    std::vector<WaveSpawn> spawns;
+    // Length of the wave in seconds
+    float duration = 0.F;
+    // Most enemies alive at once in a pass, assuming none is killed
+    size_t peak = 0;
+  };
+
+  /**
+   * @brief Parse the text of a wave file. On failure, error_line is set
+   * to the first bad line, counted from 1.
+   */
+  std::optional<Wave>
+  parse_wave(std::string_view text, size_t* error_line = nullptr);
+
+  /**
+   * @brief Read and parse a wave file
+   */
+  std::optional<Wave>
+  load_wave(char const* path, size_t* error_line = nullptr);
+
+  /**
+   * @brief Streams the spawns of a wave onto the event bus
+   *
+   * Every tick publishes the spawns that came due as one batch of
+   * SpawnEvents, so a group spawning at once lands in a single bulk
+   * acquisition of the enemy pool.
+   */
+  struct WaveScheduler {
+    /**
+     * @brief Position of the scheduler within its wave
+     */
+    struct Progress {
+      // Next spawn and the clock of the current pass
+      size_t cursor = 0;
+      float elapsed = 0.F;
+      size_t pass = 1;
+    };
+
+    // Constructor. Looping waves start over once their duration is up.
+    explicit WaveScheduler(Wave wave, bool loop = true);
+
+    /**
+     * @brief Advance the wave clock and publish the spawns that came
+     * due. Returns the number of spawns published.
+     */
+    size_t advance(float dt, sf::FloatRect bounds, EventBus& bus);
+
+    /**
+     * @brief Check if every spawn of a non-looping wave is out
+     */
+    bool done() const
+    {
+      return !this->loop_ && this->cursor_ == this->wave_.spawns.size();
+    }
+
+    Wave const& wave() const { return this->wave_; }
+
+    /**
+     * @brief Passes started so far, the current one included
+     */
+    size_t pass() const { return this->pass_; }
+
+    Progress progress() const
+    {
+      return {this->cursor_, this->elapsed_, this->pass_};
+    }
+
+    /**
+     * @brief Resume from a saved position. A cursor past the end of the
+     * wave is clamped.
+     */
+    void seek(Progress progress)
+    {
+      this->cursor_ = std::min(progress.cursor, this->wave_.spawns.size());
+      this->elapsed_ = progress.elapsed;
+      this->pass_ = progress.pass;
+    }
+
+  private:
+    Wave wave_;
+    bool loop_;
+
+    // Next spawn and the clock of the current pass
+    size_t cursor_ = 0;
+    float elapsed_ = 0.F;
+    size_t pass_ = 1;
+
+    // Sprite and animation of each behaviour's enemies
+    std::array<GameEvent::SpawnEvent, behaviour_count> prototypes_;
+    // Spawns of the current tick, reused across ticks
+    std::vector<GameEvent::SpawnEvent> batch_;
+  };
+}  //namespace kalika
+
+#endif
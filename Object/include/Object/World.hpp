@@ -1,41 +1,105 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <span>
+#include <string>
 #include <vector>
 
 #include <SFML/Window.hpp>
 
 #include <Event/GameEvent.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <Object/Animation.hpp>
 #include <Object/Bullet.hpp>
+#include <Object/Collision.hpp>
+#include <Object/Enemy.hpp>
+#include <Object/Kinematics.hpp>
+#include <Object/Particles.hpp>
 #include <Object/Player.hpp>
 #include <Object/Pool.hpp>
+#include <Object/Snapshot.hpp>
 
 namespace kalika
 {
+  /**
+   * @brief Handle to a bullet in its behaviour's partition
+   */
+  struct BulletHandle {
+    BehaviourId behaviour;
+    Handle handle;
+
+    bool operator==(BulletHandle const&) const = default;
+  };
+
+  /**
+   * @brief Memory held by one kind of entity
+   */
+  struct MemoryStats {
+    std::string name;
+    size_t live;
+    size_t slots;
+    // Bytes per entity the update streams every tick, and the rest
+    size_t hot_bytes;
+    size_t cold_bytes;
+    // Everything allocated for the kind, spare capacity included
+    size_t total_bytes;
+  };
+
   struct World {
     // Player Object
     Player player;
     // Event Bus
     EventBus* bus;
 
-    World(PlayerInfo info, EventBus* e_bus) :
-      player(info, e_bus), bus(e_bus)
-    {}
+    World(PlayerInfo info, EventBus* e_bus, JobSystem* job_system) :
+      player(info, e_bus),
+      bus(e_bus),
+      jobs_(job_system),
+      player_radius_(info.size / 2.F)
+    {
+      // Straight partitions leave out the steering columns
+      for_each_behaviour([this]<typename B>() {
+        this->partitions_[behaviour_id<B>].kin =
+          internal::Kinematics(B::motion);
+      });
+    }
 
     /**
-     * @brief Add a bullet to the world
+     * @brief Spawn a bullet in place in the bullet pool
      */
-    void add_bullet(Wrapper<Bullet> const& b_wrap)
-    {
-      this->bullets_.push_back(b_wrap);
-    }
+    BulletHandle add_bullet(GameEvent::FireEvent const& event);
+
+    /**
+     * @brief Spawn a batch of bullets with one pool acquisition per run
+     * of equal behaviours
+     */
+    void add_bullets(std::span<GameEvent::FireEvent const> events);
+
+    /**
+     * @brief Spawn every bullet of a burst pattern
+     */
+    void add_burst(GameEvent::BurstEvent const& burst);
+
+    /**
+     * @brief Release a bullet. Stale handles are ignored
+     */
+    bool release_bullet(BulletHandle handle);
 
     /**
      * @brief Update the state of objects
      */
     void update(GameContext const& ctx, float dt);
 
+    /**
+     * @brief Write simulation state to the sprites, interpolated by alpha
+     * between the previous and the current tick. Only transforms that
+     * changed since the last sync are touched.
+     */
+    void sync_render(float alpha = 1.F);
+
     using SpriteRef = std::reference_wrapper<sf::Sprite const>;
 
     std::vector<SpriteRef> sprites() const;
@@ -43,18 +107,129 @@ namespace kalika
     /**
      * @brief Number of active bullets on screen
      */
-    size_t bullet_count() const { return this->bullets_.size(); }
+    size_t bullet_count() const;
+
+    /**
+     * @brief Number of bullets allocated by the pools
+     */
+    size_t bullet_capacity() const;
+
+    /**
+     * @brief Collision pass of the last update
+     */
+    Collisions const& collisions() const { return this->collisions_; }
+
+    /**
+     * @brief Spawn a batch of enemies with one pool acquisition
+     */
+    void add_enemies(std::span<GameEvent::SpawnEvent const> events);
+
+    /**
+     * @brief Damage an enemy and release it once it dies. Returns true
+     * if the hit killed it. Stale handles are ignored
+     */
+    bool damage_enemy(Handle handle, float damage);
+
+    /**
+     * @brief Throw sparks where bullets hit enemies. Must run before the
+     * bullets are released.
+     */
+    void hit_effects(std::span<GameEvent::HitEvent const> events);
 
-    // template<typename... Args> void spawn_enemy(Args... args)
-    // {
-    //   this->enemies.acquire(args...);
-    // }
+    /**
+     * @brief Effect particles, stepped at the end of every update
+     */
+    ParticleSystem const& particles() const { return this->particles_; }
+
+    /**
+     * @brief Build enemies up front so that spawning up to count of them
+     * at once never allocates
+     */
+    void reserve_enemies(size_t count);
+
+    /**
+     * @brief Number of active enemies
+     */
+    size_t enemy_count() const { return this->enemies_.size(); }
+
+    /**
+     * @brief Number of enemies allocated by the pool
+     */
+    size_t enemy_capacity() const { return this->enemies_.capacity(); }
+
+    /**
+     * @brief Memory held by the bullets of each behaviour, by the
+     * enemies and by the particles
+     */
+    std::vector<MemoryStats> memory_stats() const;
+
+    /**
+     * @brief Hash of the player, bullet and enemy state, to check that
+     * two runs ended bit for bit the same
+     */
+    std::uint64_t digest() const;
+
+    /**
+     * @brief Add the player, bullet and enemy sections to a snapshot
+     */
+    void write_snapshot(SnapshotWriter& out) const;
+
+    /**
+     * @brief Replace the player, bullets and enemies with those of a
+     * snapshot. Handles saved with it stay valid. Returns false, leaving
+     * the world untouched, if a section is missing or inconsistent.
+     */
+    bool read_snapshot(SnapshotView const& in);
 
   private:
-    // Object Pools
-    std::vector<Wrapper<Bullet>> bullets_;
+    // Side of a collision grid cell, about an enemy across
+    static constexpr float cell_size = 64.F;
+    // Bullets per job. A multiple of the kernel lanes, so chunks of a
+    // store never share a vector.
+    static constexpr size_t chunk_size = 4096;
+    static_assert(chunk_size % internal::Kinematics::lanes == 0);
+
+    // Worker threads for the bullet update
+    JobSystem* jobs_;
+
+    /**
+     * @brief Bullets sharing a behaviour
+     */
+    struct Partition {
+      Pool<Bullet> bullets;
+      // Kinematics, in the same order as the pool's dense array
+      internal::Kinematics kin;
+    };
 
-    // Pool<Enemy> enemies_;
+    // One partition per behaviour, indexed by its id
+    std::array<Partition, behaviour_count> partitions_;
+    // Bullets of the burst being expanded, reused across bursts
+    std::vector<GameEvent::FireEvent> burst_;
+
+    Pool<Enemy> enemies_;
+    // Steps the strip animations of every enemy
+    AnimationClock animation_;
+
+    // Collision state, reused across ticks
+    float player_radius_;
+    Colliders enemy_colliders_;
+    Collisions collisions_;
+    std::vector<GameEvent::HitEvent> hits_;
+
+    // Bursts requested since the last update, spawned as one batch
+    std::vector<ParticleBurst> bursts_;
+    ParticleSystem particles_;
+
+    /**
+     * @brief Move the enemies, release the dead ones and rebuild their
+     * hit circles
+     */
+    void update_enemies(GameContext const& ctx, float dt);
+
+    /**
+     * @brief Find bullet hits and publish them as one batch
+     */
+    void collide();
   };
 }  //namespace kalika
 
@@ -4,6 +4,8 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 
+#include <Resource/Atlas.hpp>
+
 #include <cmath>
 #include <cstddef>
 #include <filesystem>
@@ -15,6 +17,8 @@ namespace kalika
 
   inline static sf::Vector2f AXIS_X = {1.F, 0.F};
   constexpr float bul_size = 16.F;
+  // Damage dealt by a bullet
+  constexpr float bul_damage = 1.F;
 
   namespace internal
   {
@@ -34,18 +38,84 @@ namespace kalika
 
     struct Drawable {
       // Player data
+      SpriteId id;
       sf::Sprite sprite;
 
-      Drawable(sf::Texture& texture) : sprite(texture) {}
+      // Last transform written to the sprite
+      sf::Vector2f pos;
+      sf::Vector2f heading;
+      bool synced = false;
+      // Frame of the strip on show
+      unsigned frame = 0;
+
+      Drawable(SpriteId sprite_id) :
+        id(sprite_id),
+        sprite(
+          atlas().texture(sprite_id), atlas().region(sprite_id).frame(0)
+        )
+      {}
+
+      /**
+       * @brief Point the sprite at another sheet in the atlas
+       */
+      void set_sprite(SpriteId sprite_id)
+      {
+        auto const& sheets = atlas();
+        // Recycled objects usually keep their sheet
+        if (sprite_id != this->id) {
+          this->id = sprite_id;
+          this->sprite.setTexture(sheets.texture(sprite_id));
+        }
+        this->sprite.setTextureRect(sheets.region(sprite_id).frame(0));
+        this->frame = 0;
+      }
+
+      /**
+       * @brief Scale the sprite so a frame is size pixels tall, centred
+       * on its position
+       */
+      void resize(float size)
+      {
+        auto const rect = sf::Vector2f(this->sprite.getTextureRect().size);
+        this->sprite.setOrigin(rect / 2.F);
+        float const s = size / rect.y;
+        this->sprite.setScale({s, s});
+      }
+
+      /**
+       * @brief Show a frame of the strip. idx must be below the sheet's
+       * frame count; the rect is only set when the frame changes.
+       */
+      void set_frame(unsigned idx)
+      {
+        if (idx != this->frame) {
+          this->frame = idx;
+          this->sprite.setTextureRect(
+            atlas().region(this->id).frame_rects[idx]
+          );
+        }
+      }
+
+      /**
+       * @brief Write the transform to the sprite if it changed. The
+       * rotation is only recomputed when the heading moves.
+       */
+      void sync(sf::Vector2f position, sf::Vector2f dir)
+      {
+        if (!this->synced || position != this->pos) {
+          this->sprite.setPosition(position);
+          this->pos = position;
+        }
+        if (!this->synced || dir != this->heading) {
+          this->sprite.setRotation(
+            sf::degrees(90.F) + dir.angleTo(AXIS_X) * -1.F
+          );
+          this->heading = dir;
+        }
+        this->synced = true;
+      }
     };
 
-    // Load texture given a file
-    inline void load_texture(sf::Texture& t, std::filesystem::path path)
-    {
-      (void)t.loadFromFile(path);
-      t.setSmooth(false);
-    }
-
   }  //namespace internal
 
   // Forward declarations
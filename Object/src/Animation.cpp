@@ -0,0 +1,45 @@
+#include <algorithm>
+
+#include <Object/Animation.hpp>
+
+namespace kalika
+{
+  // Find or add the group of a cadence
+  AnimGroup AnimationClock::group(std::size_t interval, unsigned frames)
+  {
+    interval = std::max<std::size_t>(interval, 1);
+    frames = std::max(frames, 1U);
+
+    // A handful of cadences at most, so a scan is enough
+    for (std::size_t idx = 0; idx < this->groups_.size(); idx++) {
+      auto const& group = this->groups_[idx];
+      if (group.interval == interval && group.frames == frames) {
+        return static_cast<AnimGroup>(idx);
+      }
+    }
+    this->groups_.push_back({
+      .interval = interval,
+      .frames = frames,
+      .left = interval,
+    });
+    return static_cast<AnimGroup>(this->groups_.size() - 1);
+  }
+
+  // Count down every group
+  void AnimationClock::step()
+  {
+    this->any_changed_ = false;
+    for (auto& group : this->groups_) {
+      group.changed = false;
+      if (--group.left > 0) {
+        continue;
+      }
+      group.left = group.interval;
+      unsigned const next = group.frame + 1;
+      group.frame = (next == group.frames) ? 0U : next;
+      // Single frame strips never need a new rect
+      group.changed = group.frames > 1;
+      this->any_changed_ = this->any_changed_ || group.changed;
+    }
+  }
+}  //namespace kalika
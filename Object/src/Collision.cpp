@@ -0,0 +1,148 @@
+#include <Object/Collision.hpp>
+#include <Profile/Profiler.hpp>
+
+namespace kalika
+{
+  // ====== Colliders ====== //
+  void Colliders::clear()
+  {
+    for (auto const handle : this->owner) {
+      this->slots_[handle.idx] = npos;
+    }
+    this->x.clear();
+    this->y.clear();
+    this->radius.clear();
+    this->owner.clear();
+  }
+
+  void Colliders::push(sf::Vector2f pos, float r, Handle handle)
+  {
+    if (handle.idx >= this->slots_.size()) {
+      this->slots_.resize(handle.idx + 1, npos);
+    }
+    this->slots_[handle.idx] = this->x.size();
+    this->x.push_back(pos.x);
+    this->y.push_back(pos.y);
+    this->radius.push_back(r);
+    this->owner.push_back(handle);
+  }
+
+  // ====== Collisions ====== //
+  // Place the grid
+  void Collisions::reset(
+    sf::FloatRect world, float cell_size, float bullet_radius
+  )
+  {
+    this->grid_.reset(world, cell_size);
+    this->bullet_radius_ = bullet_radius;
+  }
+
+  // Bucket the enemies
+  void Collisions::begin(
+    Colliders const& enemies, sf::Vector2f player, float radius
+  )
+  {
+    this->contacts_.clear();
+    this->player_hits_.clear();
+    this->candidates_ = 0;
+
+    auto const count = static_cast<std::uint32_t>(enemies.size());
+    this->reach_.resize(count);
+    for (std::uint32_t e = 0; e < count; e++) {
+      this->reach_[e] = enemies.radius[e] + this->bullet_radius_;
+    }
+    this->grid_.build(enemies.x, enemies.y, this->reach_);
+
+    // Enemies against the player
+    for (std::uint32_t e = 0; e < count; e++) {
+      float const dx = enemies.x[e] - player.x;
+      float const dy = enemies.y[e] - player.y;
+      float const reach = enemies.radius[e] + radius;
+      if ((dx * dx) + (dy * dy) < reach * reach) {
+        this->player_hits_.push_back(e);
+      }
+    }
+  }
+
+  // Test a partition of bullets
+  void Collisions::add_bullets(
+    BehaviourId id, std::span<float const> px, std::span<float const> py
+  )
+  {
+    KALIKA_PROFILE_SCOPE("collide");
+    if (this->grid_.empty()) {
+      return;
+    }
+    this->candidates_ +=
+      this->test_bullets(id, px, py, 0, px.size(), this->contacts_);
+  }
+
+  // Test a partition in parallel chunks
+  void Collisions::add_bullets(
+    BehaviourId id,
+    std::span<float const> px,
+    std::span<float const> py,
+    JobSystem& jobs,
+    size_t chunk
+  )
+  {
+    if (this->grid_.empty() || px.empty()) {
+      return;
+    }
+
+    auto const chunks = JobSystem::chunk_count(px.size(), chunk);
+    if (this->chunks_.size() < chunks) {
+      this->chunks_.resize(chunks);
+    }
+    jobs.parallel_for(
+      px.size(), chunk, [&](size_t index, size_t begin, size_t end) {
+        KALIKA_PROFILE_SCOPE("collide");
+        auto& result = this->chunks_[index];
+        result.contacts.clear();
+        result.candidates =
+          this->test_bullets(id, px, py, begin, end, result.contacts);
+      }
+    );
+
+    // Chunk order is slot order, so the merge is deterministic
+    for (size_t index = 0; index < chunks; index++) {
+      auto const& result = this->chunks_[index];
+      this->contacts_.insert(
+        this->contacts_.end(),
+        result.contacts.begin(),
+        result.contacts.end()
+      );
+      this->candidates_ += result.candidates;
+    }
+  }
+
+  // Narrowphase over a range of bullets
+  size_t Collisions::test_bullets(
+    BehaviourId id,
+    std::span<float const> px,
+    std::span<float const> py,
+    size_t begin,
+    size_t end,
+    std::vector<Contact>& out
+  ) const
+  {
+    size_t candidates = 0;
+    for (slot_id idx = begin; idx < end; idx++) {
+      float const bx = px[idx];
+      float const by = py[idx];
+      bool hit = false;
+
+      // Entries keep collider order, so the first overlap wins
+      this->grid_.query_point(bx, by, [&](SpatialGrid::Entry const& e) {
+        candidates++;
+        float const dx = bx - e.x;
+        float const dy = by - e.y;
+        if (!hit && (dx * dx) + (dy * dy) < e.radius * e.radius) {
+          hit = true;
+          out.push_back({id, idx, e.id});
+        }
+      });
+    }
+    return candidates;
+  }
+}  //namespace kalika
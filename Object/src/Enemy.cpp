@@ -0,0 +1,123 @@
+#include <Object/Enemy.hpp>
+
+namespace kalika
+{
+  Enemy::Enemy(GameEvent::SpawnEvent const& event, EventBus* bus) :
+    ObjBase(
+      event.position,
+      event.velocity,
+      {0.F, 1.F},
+      event.sprite,
+      event.size,
+      bus
+    )
+  {
+    this->rebuild(event, bus);
+  }
+
+  // Restore a saved enemy
+  Enemy::Enemy(EnemyState const& state, EventBus* bus) :
+    Enemy(state.spawn, bus)
+  {
+    this->mov_.up = state.up;
+    this->prev_pos_ = state.prev_pos;
+    this->update_frame();
+  }
+
+  // Rebuild enemy object
+  void Enemy::rebuild(GameEvent::SpawnEvent const& event, EventBus* bus)
+  {
+    this->mov_.pos = event.position;
+    this->mov_.vel = event.velocity;
+    if (event.velocity.lengthSquared() > 0.F) {
+      this->mov_.up = event.velocity.normalized();
+    }
+    this->draw_.set_sprite(event.sprite);
+    this->draw_.synced = false;
+    // Waves mix enemy sizes, so the scale is rebuilt too
+    this->scale(event.size);
+    this->behaviour_ = event.behaviour_id;
+    this->bus_ = bus;
+    this->alive_ = true;
+
+    this->animate_ = event.animate;
+    this->frame_count_ = static_cast<unsigned>(event.frame_count);
+    this->interval_ = static_cast<unsigned>(event.interval);
+    // Joined by the world once spawned
+    this->anim_group_ = no_anim_group;
+
+    this->radius_ = event.size / 2.F;
+    this->health_ = event.health;
+    this->life_ = event.lifetime;
+    this->prev_pos_ = event.position;
+
+    this->update_frame();
+  }
+
+  // Copy out the state
+  EnemyState Enemy::state() const
+  {
+    return {
+      .spawn =
+        {
+          .position = this->mov_.pos,
+          .velocity = this->mov_.vel,
+          .size = this->radius_ * 2.F,
+          .sprite = this->draw_.id,
+          .behaviour_id = this->behaviour_,
+          .health = this->health_,
+          .lifetime = this->life_,
+          .animate = this->animate_,
+          .frame_count = this->frame_count_,
+          .interval = this->interval_,
+        },
+      .up = this->mov_.up,
+      .prev_pos = this->prev_pos_,
+    };
+  }
+
+  // Move by a tick
+  void Enemy::update(
+    GameContext const& ctx, internal::Movable const& target, float dt
+  )
+  {
+    this->prev_pos_ = this->mov_.pos;
+    this->move(ctx, target, dt);
+
+    // Bounce off or stop at the bounds, depending on the behaviour
+    this->mov_.vel = visit_behaviour<sf::Vector2f>(
+      this->behaviour_,
+      [&](auto behaviour) {
+        return behaviour.bound_velocity(
+          ctx, this->mov_.pos, this->mov_.vel
+        );
+      },
+      this->mov_.vel
+    );
+    if (this->mov_.vel.lengthSquared() > 0.F) {
+      this->mov_.up = this->mov_.vel.normalized();
+      this->update_frame();
+    }
+
+    if (this->life_ >= 0.F) {
+      this->life_ -= dt;
+      this->alive_ = this->alive_ && this->life_ > 0.F;
+    }
+  }
+
+  // Take a hit
+  bool Enemy::damage(float amount)
+  {
+    this->health_ -= amount;
+    this->alive_ = this->alive_ && this->health_ > 0.F;
+    return !this->alive_;
+  }
+
+  // Interpolated transform
+  void Enemy::sync_render(float alpha)
+  {
+    auto const pos =
+      this->prev_pos_ + ((this->mov_.pos - this->prev_pos_) * alpha);
+    this->sync_sprite(pos, this->forward());
+  }
+}  //namespace kalika
@@ -14,7 +14,7 @@ namespace kalika
       this->spawn = false;
       // 1. Set positions of bullets
       // Assume texture is a square
-      auto [px, _] = sf::Vector2f(p.sprite().getTexture().getSize());
+      auto [px, _] = sf::Vector2f(p.sprite().getTextureRect().size);
 
       auto const start_pos = p.position();
       std::array<sf::Vector2f, RapidFire::count> const pos = {
@@ -22,18 +22,21 @@ namespace kalika
         start_pos + p.forward().rotatedBy(sf::degrees(-45)) * px,
       };
 
-      // Push events for spawning bullets
-      for (auto idx = 0UL; idx < RapidFire::count; idx++) {
-        GameEvent::FireEvent const event{
-          .position = pos[idx],
+      // Publish the bullets as one batch
+      auto const bullet = [&](sf::Vector2f position) {
+        return GameEvent::FireEvent{
+          .position = position,
           .velocity = this->velocity * p.forward(),
-          .texture = std::ref(internal::bullet_texture()),
+          .sprite = SpriteId::Bullet,
           .size = bul_size,
-          .behaviour_id = std::type_index(typeid(Dasher)),
+          .behaviour_id = behaviour_id<Dasher>,
           .lifetime = this->lifetime
         };
-        bus->emplace(event);
-      }
+      };
+      std::array<GameEvent::FireEvent, RapidFire::count> const events = {
+        bullet(pos[0]), bullet(pos[1])
+      };
+      bus->emplace_range(events);
     }
   }
 
@@ -46,38 +49,25 @@ namespace kalika
       this->spawn = false;
       // 1. Set positions of bullets
       // Assume texture is a square
-      auto [px, _] = sf::Vector2f(p.sprite().getTexture().getSize());
+      auto [px, _] = sf::Vector2f(p.sprite().getTextureRect().size);
 
-      // Set directions
-      std::array<sf::Vector2f, SpreadFire::count> const dir = {
-        p.forward().rotatedBy(sf::degrees(-15)),
-        p.forward().rotatedBy(sf::degrees(-30)),
-        p.forward().rotatedBy(sf::degrees(15)),
-        p.forward().rotatedBy(sf::degrees(30)),
-        p.forward(),
-      };
-
-      // Set positions
-      std::array<sf::Vector2f, SpreadFire::count> const pos = {
-        p.position() + (dir[0]) * px,
-        p.position() + (dir[1]) * px,
-        p.position() + (dir[2]) * px,
-        p.position() + (dir[3]) * px,
-        p.position() + (dir[4]) * px / 2.F
-      };
-
-      // 2. Generate info and add bullets
-      for (auto idx = 0UL; idx < SpreadFire::count; idx++) {
-        GameEvent::FireEvent const event{
-          .position = pos[idx],
-          .velocity = this->velocity * dir[idx],
-          .texture = std::ref(internal::bullet_texture()),
+      // 2. One fan from -arc to arc
+      constexpr float step = 2.F * arc / static_cast<float>(count - 1);
+      bus->emplace(
+        GameEvent::BurstEvent{
+          .origin = p.position(),
+          .forward = p.forward(),
+          .start = sf::degrees(-arc),
+          .step = sf::degrees(step),
+          .count = count,
+          .radius = px,
+          .speed = this->velocity,
+          .sprite = SpriteId::Bullet,
           .size = bul_size,
-          .behaviour_id = std::type_index(typeid(Dasher)),
-          .lifetime = this->lifetime
-        };
-        bus->emplace(event);
-      }
+          .behaviour_id = behaviour_id<Dasher>,
+          .lifetime = this->lifetime,
+        }
+      );
     }
   }
 
@@ -88,16 +78,16 @@ namespace kalika
     // Spawn bullets if offset has passed
     if (this->spawn_check(dt)) {
       // 1. Set positions of bullets
-      auto [px, _] = sf::Vector2f(p.sprite().getTexture().getSize());
+      auto [px, _] = sf::Vector2f(p.sprite().getTextureRect().size);
 
       // 2. Generate info and add bullets
       auto angle = this->toggle_ ? sf::degrees(45) : sf::degrees(-45);
       GameEvent::FireEvent const event{
         .position = p.position() + p.forward().rotatedBy(angle) * px,
         .velocity = this->velocity * p.forward(),
-        .texture = std::ref(internal::bullet_texture()),
+        .sprite = SpriteId::Bullet,
         .size = bul_size,
-        .behaviour_id = std::type_index(typeid(Chaser)),
+        .behaviour_id = behaviour_id<Chaser>,
         .lifetime = this->lifetime
       };
       bus->emplace(event);
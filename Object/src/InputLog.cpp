@@ -0,0 +1,172 @@
+#include <array>
+#include <fstream>
+#include <istream>
+#include <ostream>
+
+#include <Object/InputLog.hpp>
+#include <Object/Player.hpp>
+
+namespace kalika
+{
+  namespace
+  {
+    constexpr std::array<char, 4> magic = {'K', 'I', 'N', 'P'};
+
+    // Raw bytes of a field, in native order
+    template<typename T> void put(std::ostream& out, T const& value)
+    {
+      out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template<typename T> bool get(std::istream& in, T& value)
+    {
+      return static_cast<bool>(
+        in.read(reinterpret_cast<char*>(&value), sizeof(T))
+      );
+    }
+
+    void put(std::ostream& out, sf::Vector2f value)
+    {
+      put(out, value.x);
+      put(out, value.y);
+    }
+
+    bool get(std::istream& in, sf::Vector2f& value)
+    {
+      return get(in, value.x) && get(in, value.y);
+    }
+  }  //namespace
+
+  // Frames are appended in tick order
+  InputFrame& InputLog::frame(std::uint32_t tick)
+  {
+    if (this->frames.empty() || this->frames.back().tick != tick) {
+      this->frames.push_back({.tick = tick});
+    }
+    return this->frames.back();
+  }
+
+  // Record stick positions that changed
+  void
+  InputLog::record(std::uint32_t tick, GameEvent::MoveEvent const& event)
+  {
+    if (this->last_move_ &&
+        this->last_move_->l_strength == event.l_strength &&
+        this->last_move_->r_strength == event.r_strength) {
+      return;
+    }
+    this->last_move_ = event;
+
+    auto& frame = this->frame(tick);
+    frame.mask |= InputFrame::has_move;
+    frame.l_strength = event.l_strength;
+    frame.r_strength = event.r_strength;
+  }
+
+  // Record a fire mode switch
+  void InputLog::record(
+    std::uint32_t tick, GameEvent::SwitchEvent const& event
+  )
+  {
+    auto& frame = this->frame(tick);
+    frame.mask |= InputFrame::has_switch;
+    frame.fire_id = static_cast<std::uint32_t>(event.fire_id);
+  }
+
+  // Write header and frames
+  bool InputLog::write(std::ostream& out) const
+  {
+    out.write(magic.data(), magic.size());
+    put(out, version);
+    put(out, this->dt);
+    put(out, this->dimensions.x);
+    put(out, this->dimensions.y);
+    put(out, this->ticks);
+    put(out, static_cast<std::uint32_t>(this->frames.size()));
+
+    for (auto const& frame : this->frames) {
+      put(out, frame.tick);
+      put(out, frame.mask);
+      if ((frame.mask & InputFrame::has_move) != 0U) {
+        put(out, frame.l_strength);
+        put(out, frame.r_strength);
+      }
+      if ((frame.mask & InputFrame::has_switch) != 0U) {
+        put(out, frame.fire_id);
+      }
+    }
+    return static_cast<bool>(out);
+  }
+
+  bool InputLog::save(char const* path) const
+  {
+    std::ofstream file(path, std::ios::binary);
+    return file && this->write(file);
+  }
+
+  // Read header and frames
+  std::optional<InputLog> InputLog::read(std::istream& in)
+  {
+    std::array<char, 4> head{};
+    std::uint32_t file_version = 0;
+    std::uint32_t count = 0;
+    InputLog log;
+    if (!in.read(head.data(), head.size()) || head != magic ||
+        !get(in, file_version) || file_version != version ||
+        !get(in, log.dt) || !get(in, log.dimensions.x) ||
+        !get(in, log.dimensions.y) || !get(in, log.ticks) ||
+        !get(in, count)) {
+      return std::nullopt;
+    }
+
+    // The count comes from the file; let a short stream end the loop
+    // rather than reserving blindly
+    for (std::uint32_t i = 0; i < count; i++) {
+      InputFrame frame{};
+      if (!get(in, frame.tick) || !get(in, frame.mask)) {
+        return std::nullopt;
+      }
+      if ((frame.mask & InputFrame::has_move) != 0U &&
+          !(get(in, frame.l_strength) && get(in, frame.r_strength))) {
+        return std::nullopt;
+      }
+      // A mode the player does not have means a foreign or damaged log
+      if ((frame.mask & InputFrame::has_switch) != 0U &&
+          (!get(in, frame.fire_id) ||
+           frame.fire_id >= Player::NUM_MODES)) {
+        return std::nullopt;
+      }
+      log.frames.push_back(frame);
+    }
+    return log;
+  }
+
+  std::optional<InputLog> InputLog::load(char const* path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return std::nullopt;
+    }
+    return read(file);
+  }
+
+  // Publish the frame of the tick, if it has one
+  void InputReplay::feed(std::uint32_t tick, EventBus& bus)
+  {
+    auto const& frames = this->log_->frames;
+    while (this->cursor_ < frames.size() &&
+           frames[this->cursor_].tick <= tick) {
+      auto const& frame = frames[this->cursor_++];
+      if ((frame.mask & InputFrame::has_move) != 0U) {
+        bus.emplace(
+          GameEvent::MoveEvent{
+            .l_strength = frame.l_strength, .r_strength = frame.r_strength
+          }
+        );
+      }
+      if ((frame.mask & InputFrame::has_switch) != 0U) {
+        bus.emplace(GameEvent::SwitchEvent{frame.fire_id});
+      }
+    }
+  }
+}  //namespace kalika
@@ -0,0 +1,161 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <cstddef>
+
+#include <Object/Kinematics.hpp>
+#include <Object/Particles.hpp>
+
+// Private to the Object library. Each Kernel*.cpp is compiled for its own
+// instruction set and instantiates integrate_lanes and particle_lanes
+// with a vector type local to that file, so no SIMD code leaks into the
+// other units.
+
+namespace kalika::internal
+{
+  // Entry points for each instruction set
+  void integrate_sse(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  );
+  void integrate_avx2(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  );
+  void integrate_avx512(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  );
+  void step_particles_sse(
+    ParticleView const& view, ParticleParams const& params
+  );
+  void step_particles_avx2(
+    ParticleView const& view, ParticleParams const& params
+  );
+  void step_particles_avx512(
+    ParticleView const& view, ParticleParams const& params
+  );
+
+  /**
+   * @brief Integration kernel written against a vector type V
+   *
+   * Mirrors integrate_scalar lane by lane. Straight motion only moves
+   * the position: velocity is loaded for the step but never stored, and
+   * heading is left untouched.
+   */
+  template<typename V, Motion M>
+  void
+  integrate_lanes(KinematicsView const& view, StepParams const& params)
+  {
+    auto const dt = V::set1(params.dt);
+    auto const zero = V::set1(0.F);
+    auto const left = V::set1(params.left);
+    auto const top = V::set1(params.top);
+    auto const right = V::set1(params.left + params.width);
+    auto const bottom = V::set1(params.top + params.height);
+
+    for (size_t i = 0; i < view.count; i += V::width) {
+      auto px = V::load(view.px + i);
+      auto py = V::load(view.py + i);
+      auto vx = V::load(view.vx + i);
+      auto vy = V::load(view.vy + i);
+
+      // Euler step for the position
+      auto const nx = V::add(px, V::mul(vx, dt));
+      auto const ny = V::add(py, V::mul(vy, dt));
+
+      if constexpr (M == Motion::Homing) {
+        auto dx = V::load(view.dx + i);
+        auto dy = V::load(view.dy + i);
+
+        // Homing acceleration towards the target
+        auto const update = homing_turn<V>(
+          V::sub(V::load(view.tx + i), px),
+          V::sub(V::load(view.ty + i), py),
+          dx,
+          dy,
+          V::load(view.homing + i)
+        );
+        auto const ax = V::mul(V::sub(zero, vy), update);
+        auto const ay = V::mul(vx, update);
+
+        // Euler step for the velocity
+        vx = V::add(vx, V::mul(ax, dt));
+        vy = V::add(vy, V::mul(ay, dt));
+
+        // Heading follows the velocity
+        auto const speed =
+          V::sqrt(V::add(V::mul(vx, vx), V::mul(vy, vy)));
+        auto const moving = V::gt(speed, zero);
+        dx = V::select(moving, V::div(vx, speed), dx);
+        dy = V::select(moving, V::div(vy, speed), dy);
+
+        V::store(view.vx + i, vx);
+        V::store(view.vy + i, vy);
+        V::store(view.dx + i, dx);
+        V::store(view.dy + i, dy);
+      }
+      px = nx;
+      py = ny;
+
+      // Lifetime countdown and bounds check
+      auto const life = V::sub(V::load(view.life + i), dt);
+      auto alive = V::both(V::ge(px, left), V::lt(px, right));
+      alive = V::both(alive, V::both(V::ge(py, top), V::lt(py, bottom)));
+      alive = V::both(alive, V::gt(life, zero));
+
+      V::store(view.px + i, px);
+      V::store(view.py + i, py);
+      V::store(view.life + i, life);
+      V::store_mask(view.alive + i, alive);
+    }
+  }
+
+  /**
+   * @brief Instantiate the kernel of every motion model for V
+   */
+  template<typename V>
+  void integrate_motion(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  )
+  {
+    switch (motion) {
+    case Motion::Straight:
+      integrate_lanes<V, Motion::Straight>(view, params);
+      break;
+    case Motion::Homing:
+      integrate_lanes<V, Motion::Homing>(view, params);
+      break;
+    }
+  }
+
+  /**
+   * @brief Particle kernel written against a vector type V
+   *
+   * Mirrors the scalar particle step lane by lane. Expired lanes keep
+   * counting down and stay at zero fade until they are dropped.
+   */
+  template<typename V>
+  void
+  particle_lanes(ParticleView const& view, ParticleParams const& params)
+  {
+    auto const dt = V::set1(params.dt);
+    auto const damp = V::set1(params.damp);
+    auto const zero = V::set1(0.F);
+
+    for (size_t i = 0; i < view.count; i += V::width) {
+      auto const vx = V::load(view.vx + i);
+      auto const vy = V::load(view.vy + i);
+      V::store(view.px + i, V::add(V::load(view.px + i), V::mul(vx, dt)));
+      V::store(view.py + i, V::add(V::load(view.py + i), V::mul(vy, dt)));
+      V::store(view.vx + i, V::mul(vx, damp));
+      V::store(view.vy + i, V::mul(vy, damp));
+
+      auto const life = V::sub(V::load(view.life + i), dt);
+      V::store(view.life + i, life);
+      V::store(
+        view.fade + i,
+        V::mul(V::max(life, zero), V::load(view.inv_lifetime + i))
+      );
+    }
+  }
+}  //namespace kalika::internal
+
+#endif
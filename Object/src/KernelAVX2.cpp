@@ -0,0 +1,79 @@
+#include <immintrin.h>
+
+#include "Kernel.hpp"
+
+namespace
+{
+  /**
+   * @brief 8-wide AVX2 vector
+   */
+  struct Avx2 {
+    using reg = __m256;
+    using mask = __m256;
+    static constexpr size_t width = 8;
+
+    static reg load(float const* p) { return _mm256_loadu_ps(p); }
+
+    static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+
+    static void store_mask(std::uint32_t* p, mask m)
+    {
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(p), _mm256_castps_si256(m)
+      );
+    }
+
+    static reg set1(float f) { return _mm256_set1_ps(f); }
+
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+
+    static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+
+    static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+
+    static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+
+    static mask gt(reg a, reg b)
+    {
+      return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+    }
+
+    static mask ge(reg a, reg b)
+    {
+      return _mm256_cmp_ps(a, b, _CMP_GE_OQ);
+    }
+
+    static mask lt(reg a, reg b)
+    {
+      return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+    }
+
+    static mask both(mask a, mask b) { return _mm256_and_ps(a, b); }
+
+    static reg select(mask m, reg a, reg b)
+    {
+      return _mm256_blendv_ps(b, a, m);
+    }
+  };
+}  //namespace
+
+namespace kalika::internal
+{
+  void integrate_avx2(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  )
+  {
+    integrate_motion<Avx2>(view, params, motion);
+  }
+
+  void step_particles_avx2(
+    ParticleView const& view, ParticleParams const& params
+  )
+  {
+    particle_lanes<Avx2>(view, params);
+  }
+}  //namespace kalika::internal
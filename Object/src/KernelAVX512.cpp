@@ -0,0 +1,77 @@
+#include <immintrin.h>
+
+#include "Kernel.hpp"
+
+namespace
+{
+  /**
+   * @brief 16-wide AVX-512 vector
+   */
+  struct Avx512 {
+    using reg = __m512;
+    using mask = __mmask16;
+    static constexpr size_t width = 16;
+
+    static reg load(float const* p) { return _mm512_loadu_ps(p); }
+
+    static void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+
+    static void store_mask(std::uint32_t* p, mask m)
+    {
+      _mm512_storeu_si512(p, _mm512_maskz_set1_epi32(m, -1));
+    }
+
+    static reg set1(float f) { return _mm512_set1_ps(f); }
+
+    static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+
+    static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+
+    static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+
+    static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+
+    static reg sqrt(reg a) { return _mm512_sqrt_ps(a); }
+
+    static reg max(reg a, reg b) { return _mm512_max_ps(a, b); }
+
+    static mask gt(reg a, reg b)
+    {
+      return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+    }
+
+    static mask ge(reg a, reg b)
+    {
+      return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ);
+    }
+
+    static mask lt(reg a, reg b)
+    {
+      return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+    }
+
+    static mask both(mask a, mask b) { return _mm512_kand(a, b); }
+
+    static reg select(mask m, reg a, reg b)
+    {
+      return _mm512_mask_blend_ps(m, b, a);
+    }
+  };
+}  //namespace
+
+namespace kalika::internal
+{
+  void integrate_avx512(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  )
+  {
+    integrate_motion<Avx512>(view, params, motion);
+  }
+
+  void step_particles_avx512(
+    ParticleView const& view, ParticleParams const& params
+  )
+  {
+    particle_lanes<Avx512>(view, params);
+  }
+}  //namespace kalika::internal
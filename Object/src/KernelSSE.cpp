@@ -0,0 +1,68 @@
+#include <immintrin.h>
+
+#include "Kernel.hpp"
+
+namespace
+{
+  /**
+   * @brief 4-wide SSE4.1 vector
+   */
+  struct Sse {
+    using reg = __m128;
+    using mask = __m128;
+    static constexpr size_t width = 4;
+
+    static reg load(float const* p) { return _mm_loadu_ps(p); }
+
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+
+    static void store_mask(std::uint32_t* p, mask m)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_castps_si128(m));
+    }
+
+    static reg set1(float f) { return _mm_set1_ps(f); }
+
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+
+    static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+
+    static reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+
+    static mask gt(reg a, reg b) { return _mm_cmpgt_ps(a, b); }
+
+    static mask ge(reg a, reg b) { return _mm_cmpge_ps(a, b); }
+
+    static mask lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+
+    static mask both(mask a, mask b) { return _mm_and_ps(a, b); }
+
+    static reg select(mask m, reg a, reg b)
+    {
+      return _mm_blendv_ps(b, a, m);
+    }
+  };
+}  //namespace
+
+namespace kalika::internal
+{
+  void integrate_sse(
+    KinematicsView const& view, StepParams const& params, Motion motion
+  )
+  {
+    integrate_motion<Sse>(view, params, motion);
+  }
+
+  void step_particles_sse(
+    ParticleView const& view, ParticleParams const& params
+  )
+  {
+    particle_lanes<Sse>(view, params);
+  }
+}  //namespace kalika::internal
@@ -0,0 +1,333 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Kernel.hpp"
+#include <Object/Kinematics.hpp>
+
+namespace kalika::internal
+{
+  namespace
+  {
+    // Reference implementation the vector kernels are checked against
+    template<Motion M>
+    void
+    integrate_scalar(KinematicsView const& view, StepParams const& params)
+    {
+      float const dt = params.dt;
+      float const right = params.left + params.width;
+      float const bottom = params.top + params.height;
+
+      for (size_t i = 0; i < view.count; i++) {
+        float const px = view.px[i];
+        float const py = view.py[i];
+        float const vx = view.vx[i];
+        float const vy = view.vy[i];
+
+        if constexpr (M == Motion::Homing) {
+          float const dx = view.dx[i];
+          float const dy = view.dy[i];
+
+          // Homing acceleration towards the target
+          float const update = homing_turn<Lane>(
+            view.tx[i] - px, view.ty[i] - py, dx, dy, view.homing[i]
+          );
+
+          view.vx[i] = vx + (-vy * update * dt);
+          view.vy[i] = vy + (vx * update * dt);
+
+          // Heading follows the velocity
+          float const nvx = view.vx[i];
+          float const nvy = view.vy[i];
+          float const speed = std::sqrt((nvx * nvx) + (nvy * nvy));
+          if (speed > 0.F) {
+            view.dx[i] = nvx / speed;
+            view.dy[i] = nvy / speed;
+          }
+        }
+
+        // Euler step
+        view.px[i] = px + (vx * dt);
+        view.py[i] = py + (vy * dt);
+
+        // Lifetime countdown and bounds check
+        view.life[i] -= dt;
+        bool const inside =
+          view.px[i] >= params.left && view.px[i] < right &&
+          view.py[i] >= params.top && view.py[i] < bottom;
+        view.alive[i] = (inside && view.life[i] > 0.F) ? ~0U : 0U;
+      }
+    }
+  }  //namespace
+
+  // ====== Kinematics store ====== //
+  // Append an object
+  size_t Kinematics::push(
+    float pos_x,
+    float pos_y,
+    float vel_x,
+    float vel_y,
+    float lifetime,
+    float homing_factor
+  )
+  {
+    size_t const idx = this->extend(1);
+    this->set(idx, pos_x, pos_y, vel_x, vel_y, lifetime, homing_factor);
+    return idx;
+  }
+
+  // Append a batch of objects
+  size_t Kinematics::extend(size_t count)
+  {
+    size_t const first = this->count_;
+    this->count_ += count;
+    if (this->count_ > this->px.size()) {
+      this->resize((this->count_ + lanes - 1) / lanes * lanes);
+    }
+    return first;
+  }
+
+  // Write every column of an object
+  void Kinematics::set(
+    size_t idx,
+    float pos_x,
+    float pos_y,
+    float vel_x,
+    float vel_y,
+    float lifetime,
+    float homing_factor
+  )
+  {
+    // Heading starts along the velocity
+    float const speed = std::sqrt((vel_x * vel_x) + (vel_y * vel_y));
+
+    this->px[idx] = pos_x;
+    this->py[idx] = pos_y;
+    this->ox[idx] = pos_x;
+    this->oy[idx] = pos_y;
+    this->vx[idx] = vel_x;
+    this->vy[idx] = vel_y;
+    this->dx[idx] = (speed > 0.F) ? vel_x / speed : 0.F;
+    this->dy[idx] = (speed > 0.F) ? vel_y / speed : -1.F;
+    this->life[idx] = lifetime;
+    this->alive[idx] = ~0U;
+    if (!this->steers_) {
+      return;
+    }
+    // No target yet: aiming at itself does not steer
+    this->tx[idx] = pos_x;
+    this->ty[idx] = pos_y;
+    this->homing[idx] = homing_factor;
+    this->target[idx] = {};
+  }
+
+  // Swap the last object into the removed slot
+  void Kinematics::swap_remove(size_t idx)
+  {
+    size_t const last = --this->count_;
+    if (idx == last) {
+      return;
+    }
+
+    for (auto* column : this->columns()) {
+      (*column)[idx] = (*column)[last];
+    }
+    this->alive[idx] = this->alive[last];
+    if (this->steers_) {
+      for (auto* column : this->steering()) {
+        (*column)[idx] = (*column)[last];
+      }
+      this->target[idx] = this->target[last];
+    }
+  }
+
+  // Copy positions for interpolation
+  void Kinematics::save_positions()
+  {
+    this->save_positions(0, this->count_);
+  }
+
+  void Kinematics::save_positions(size_t begin, size_t end)
+  {
+    auto const count = static_cast<std::ptrdiff_t>(end - begin);
+    auto const first = static_cast<std::ptrdiff_t>(begin);
+    std::copy_n(this->px.begin() + first, count, this->ox.begin() + first);
+    std::copy_n(this->py.begin() + first, count, this->oy.begin() + first);
+  }
+
+  // Raw view for the kernels. Live lanes only, rounded up to whole
+  // vectors: the columns keep the capacity of the largest wave.
+  KinematicsView Kinematics::view()
+  {
+    return {
+      .px = this->px.data(),
+      .py = this->py.data(),
+      .vx = this->vx.data(),
+      .vy = this->vy.data(),
+      .dx = this->dx.data(),
+      .dy = this->dy.data(),
+      .tx = this->tx.data(),
+      .ty = this->ty.data(),
+      .homing = this->homing.data(),
+      .life = this->life.data(),
+      .alive = this->alive.data(),
+      .count = (this->count_ + lanes - 1) / lanes * lanes,
+    };
+  }
+
+  KinematicsView Kinematics::view(size_t begin, size_t end)
+  {
+    return {
+      .px = this->px.data() + begin,
+      .py = this->py.data() + begin,
+      .vx = this->vx.data() + begin,
+      .vy = this->vy.data() + begin,
+      .dx = this->dx.data() + begin,
+      .dy = this->dy.data() + begin,
+      // Straight stores have no steering columns to offset
+      .tx = this->steers_ ? this->tx.data() + begin : nullptr,
+      .ty = this->steers_ ? this->ty.data() + begin : nullptr,
+      .homing = this->steers_ ? this->homing.data() + begin : nullptr,
+      .life = this->life.data() + begin,
+      .alive = this->alive.data() + begin,
+      .count = end - begin,
+    };
+  }
+
+  // Grow all columns
+  void Kinematics::resize(size_t padded)
+  {
+    for (auto* column : this->columns()) {
+      column->resize(padded);
+    }
+    this->alive.resize(padded);
+    if (this->steers_) {
+      for (auto* column : this->steering()) {
+        column->resize(padded);
+      }
+      this->target.resize(padded);
+    }
+  }
+
+  // Sum the column capacities
+  size_t Kinematics::allocated_bytes() const
+  {
+    size_t floats = 0;
+    for (auto const* column : {&px, &py, &ox, &oy, &vx, &vy, &dx, &dy,
+                               &life, &tx, &ty, &homing}) {
+      floats += column->capacity();
+    }
+    return (floats * sizeof(float)) +
+           (this->alive.capacity() * sizeof(std::uint32_t)) +
+           (this->target.capacity() * sizeof(Handle));
+  }
+
+  // ====== Dispatch ====== //
+  // Query the CPU once
+  SimdLevel detect_simd()
+  {
+#ifdef KALIKA_SIMD_X86
+    static SimdLevel const level = [] {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::Avx512;
+      }
+      if (__builtin_cpu_supports("avx2") &&
+          __builtin_cpu_supports("fma")) {
+        return SimdLevel::Avx2;
+      }
+      if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::Sse;
+      }
+      return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+  }
+
+  // Instruction set names
+  char const* simd_name(SimdLevel level)
+  {
+    switch (level) {
+    case SimdLevel::Sse:
+      return "SSE4.1";
+    case SimdLevel::Avx2:
+      return "AVX2";
+    case SimdLevel::Avx512:
+      return "AVX-512";
+    default:
+      return "Scalar";
+    }
+  }
+
+  namespace
+  {
+    // Run the kernel of an instruction set over a view
+    void integrate_view(
+      KinematicsView const& view,
+      StepParams const& params,
+      Motion motion,
+      SimdLevel level
+    )
+    {
+      switch (level) {
+#ifdef KALIKA_SIMD_X86
+      case SimdLevel::Sse:
+        integrate_sse(view, params, motion);
+        break;
+      case SimdLevel::Avx2:
+        integrate_avx2(view, params, motion);
+        break;
+      case SimdLevel::Avx512:
+        integrate_avx512(view, params, motion);
+        break;
+#endif
+      default:
+        if (motion == Motion::Homing) {
+          integrate_scalar<Motion::Homing>(view, params);
+        }
+        else {
+          integrate_scalar<Motion::Straight>(view, params);
+        }
+        break;
+      }
+    }
+  }  //namespace
+
+  // Run the kernel for the requested instruction set
+  void integrate(
+    Kinematics& kin,
+    StepParams const& params,
+    Motion motion,
+    SimdLevel level
+  )
+  {
+    // Nothing to steer by without the steering columns
+    if (!kin.steers()) {
+      motion = Motion::Straight;
+    }
+    integrate_view(kin.view(), params, motion, level);
+  }
+
+  void
+  integrate(Kinematics& kin, StepParams const& params, Motion motion)
+  {
+    integrate(kin, params, motion, detect_simd());
+  }
+
+  // Integrate a range of the store
+  void integrate(
+    Kinematics& kin,
+    StepParams const& params,
+    Motion motion,
+    size_t begin,
+    size_t end
+  )
+  {
+    if (!kin.steers()) {
+      motion = Motion::Straight;
+    }
+    integrate_view(kin.view(begin, end), params, motion, detect_simd());
+  }
+}  //namespace kalika::internal
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <Object/ObjBase.hpp>
 
 namespace kalika::internal
@@ -7,11 +9,11 @@ namespace kalika::internal
     sf::Vector2f position,
     sf::Vector2f velocity,
     sf::Vector2f dir,
-    sf::Texture& sprite_tex,
+    SpriteId sprite_id,
     float obj_size,
     EventBus* bus
   ) :
-    bus_(bus), draw_(sprite_tex)
+    bus_(bus), draw_(sprite_id)
   {
     // Customize sprite
     this->scale(obj_size);
@@ -28,23 +30,16 @@ namespace kalika::internal
 
   // Move the derived object by a frame
   void ObjBase::move(
-    GameContext const& ctx, internal::Movable const& target, float dt
+    GameContext const&, internal::Movable const& target, float dt
   )
   {
-    // Swap frames for animations
-    if (animate_) {
-      this->animate(ctx);
-    }
-
     // Update kinetic data
-    auto accel = (this->behaviour_ != nullptr)
-                   ? std::visit(
-                       [&target, this](auto const& var) {
-                         return var.accel(this->mov_, target);
-                       },
-                       *this->behaviour_
-                     )
-                   : sf::Vector2f{};
+    auto const accel = visit_behaviour<sf::Vector2f>(
+      this->behaviour_,
+      [&target, this](auto behaviour) {
+        return behaviour.accel(this->mov_, target);
+      }
+    );
     this->mov_.pos += this->velocity() * dt;
     this->mov_.vel = this->velocity() + (accel * dt);
 
@@ -58,30 +53,27 @@ namespace kalika::internal
     // Normalize co-ordinate axes
     this->mov_.up = normalize(this->mov_.up).value_or(this->forward());
     this->mov_.right = this->mov_.up.perpendicular();
-
-    // Move the sprite
-    this->draw_.sprite.setPosition(this->position());
-    this->draw_.sprite.setRotation(
-      sf::degrees(90.F) + this->forward().angleTo(AXIS_X) * -1.F
-    );
   }
 
-  void ObjBase::animate(GameContext const& ctx)
+  // Join an animation group
+  void ObjBase::join(AnimationClock& clock)
   {
-    // Get the frame number
-    auto frame_num = (ctx.frame_count / this->interval_) % frame_count_;
-    auto xs = (frame_num == 0) ? 0UL : (fx * frame_num) - 1;
-    // Set the sprite to the matching frame
-    this->set_frame(sf::Vector2u(xs, 0UL), sf::Vector2u(fx, fy));
+    auto const sheet_frames = atlas().region(this->draw_.id).frames;
+    if (!this->animate_ || sheet_frames < 2) {
+      this->anim_group_ = no_anim_group;
+      return;
+    }
+
+    // Never step past the end of the strip
+    this->anim_group_ = clock.group(
+      this->interval_, std::min(this->frame_count_, sheet_frames)
+    );
+    this->draw_.set_frame(clock.frame(this->anim_group_));
   }
 
   // Scale the texture
   void ObjBase::scale(float sprite_size)
   {
-    auto size = sf::Vector2f(this->sprite().getTexture().getSize());
-    this->sprite().setTextureRect({{}, sf::Vector2i(size)});
-    this->sprite().setOrigin(size / 2.F);
-    float const s = sprite_size / size.y;
-    this->sprite().scale({s, s});
+    this->draw_.resize(sprite_size);
   }
 }  //namespace kalika::internal
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "Kernel.hpp"
+#include <Object/Particles.hpp>
+
+namespace kalika
+{
+  namespace internal
+  {
+    namespace
+    {
+      // Reference implementation the vector kernels are checked against
+      void step_particles_scalar(
+        ParticleView const& view, ParticleParams const& params
+      )
+      {
+        for (size_t i = 0; i < view.count; i++) {
+          view.px[i] += view.vx[i] * params.dt;
+          view.py[i] += view.vy[i] * params.dt;
+          view.vx[i] *= params.damp;
+          view.vy[i] *= params.damp;
+          view.life[i] -= params.dt;
+          view.fade[i] =
+            std::fmax(view.life[i], 0.F) * view.inv_lifetime[i];
+        }
+      }
+    }  //namespace
+
+    // Run the kernel of an instruction set over a view
+    void step_particles(
+      ParticleView const& view,
+      ParticleParams const& params,
+      SimdLevel level
+    )
+    {
+      switch (level) {
+#ifdef KALIKA_SIMD_X86
+      case SimdLevel::Sse:
+        step_particles_sse(view, params);
+        break;
+      case SimdLevel::Avx2:
+        step_particles_avx2(view, params);
+        break;
+      case SimdLevel::Avx512:
+        step_particles_avx512(view, params);
+        break;
+#endif
+      default:
+        step_particles_scalar(view, params);
+        break;
+      }
+    }
+  }  //namespace internal
+
+  // Constructor. Every column is padded for the widest kernel.
+  ParticleSystem::ParticleSystem(size_t capacity) : capacity_(capacity)
+  {
+    constexpr auto lanes = internal::Kinematics::lanes;
+    size_t const padded = (capacity + lanes - 1) / lanes * lanes;
+    for (auto& store : this->stores_) {
+      for (auto* column : {&store.px, &store.py, &store.vx, &store.vy,
+                           &store.life, &store.inv_lifetime,
+                           &store.fade}) {
+        column->resize(padded);
+      }
+    }
+  }
+
+  // Write straight into the preallocated columns
+  size_t ParticleSystem::emit(std::span<ParticleBurst const> bursts)
+  {
+    size_t spawned = 0;
+    for (auto const& burst : bursts) {
+      auto const& look = style(burst.kind);
+      auto& store = this->stores_[static_cast<size_t>(burst.kind)];
+      auto const wanted =
+        static_cast<size_t>(std::ceil(burst.strength * look.per_unit));
+      size_t const count =
+        std::min(wanted, this->capacity_ - store.count);
+      this->dropped_ += wanted - count;
+
+      for (size_t n = 0; n < count; n++) {
+        size_t const idx = store.count++;
+        float const angle =
+          this->random() * 2.F * std::numbers::pi_v<float>;
+        float const speed =
+          std::lerp(look.min_speed, look.max_speed, this->random());
+        float const lifetime =
+          std::lerp(look.min_life, look.max_life, this->random());
+
+        store.px[idx] = burst.position.x;
+        store.py[idx] = burst.position.y;
+        store.vx[idx] = (std::cos(angle) * speed) + burst.velocity.x;
+        store.vy[idx] = (std::sin(angle) * speed) + burst.velocity.y;
+        store.life[idx] = lifetime;
+        store.inv_lifetime[idx] = 1.F / lifetime;
+        store.fade[idx] = 1.F;
+      }
+      spawned += count;
+    }
+    return spawned;
+  }
+
+  void ParticleSystem::update(float dt)
+  {
+    this->update(dt, internal::detect_simd());
+  }
+
+  // Step every lane, then swap the expired particles out
+  void ParticleSystem::update(float dt, internal::SimdLevel level)
+  {
+    for (size_t kind = 0; kind < particle_kinds; kind++) {
+      auto& store = this->stores_[kind];
+      if (store.count == 0) {
+        continue;
+      }
+      internal::ParticleParams const params{
+        .dt = dt,
+        .damp = std::fmax(1.F - (particle_styles[kind].drag * dt), 0.F),
+      };
+      internal::step_particles(store.view(), params, level);
+
+      for (size_t idx = 0; idx < store.count;) {
+        if (store.life[idx] > 0.F) {
+          idx++;
+          continue;
+        }
+        size_t const last = --store.count;
+        for (auto* column : {&store.px, &store.py, &store.vx, &store.vy,
+                             &store.life, &store.inv_lifetime,
+                             &store.fade}) {
+          (*column)[idx] = (*column)[last];
+        }
+      }
+    }
+  }
+
+  void ParticleSystem::clear()
+  {
+    for (auto& store : this->stores_) {
+      store.count = 0;
+    }
+  }
+
+  ParticleColumns ParticleSystem::columns(ParticleKind kind) const
+  {
+    auto const& store = this->stores_[static_cast<size_t>(kind)];
+    return {
+      .style = style(kind),
+      .x = std::span(store.px.data(), store.count),
+      .y = std::span(store.py.data(), store.count),
+      .fade = std::span(store.fade.data(), store.count),
+    };
+  }
+
+  size_t ParticleSystem::size() const
+  {
+    size_t count = 0;
+    for (auto const& store : this->stores_) {
+      count += store.count;
+    }
+    return count;
+  }
+
+  size_t ParticleSystem::size(ParticleKind kind) const
+  {
+    return this->stores_[static_cast<size_t>(kind)].count;
+  }
+
+  size_t ParticleSystem::allocated_bytes() const
+  {
+    size_t floats = 0;
+    for (auto const& store : this->stores_) {
+      for (auto const* column : {&store.px, &store.py, &store.vx,
+                                 &store.vy, &store.life,
+                                 &store.inv_lifetime, &store.fade}) {
+        floats += column->capacity();
+      }
+    }
+    return floats * sizeof(float);
+  }
+
+  // Whole padded columns: the kernels never need a scalar tail
+  internal::ParticleView ParticleSystem::Store::view()
+  {
+    constexpr auto lanes = internal::Kinematics::lanes;
+    return {
+      .px = this->px.data(),
+      .py = this->py.data(),
+      .vx = this->vx.data(),
+      .vy = this->vy.data(),
+      .life = this->life.data(),
+      .inv_lifetime = this->inv_lifetime.data(),
+      .fade = this->fade.data(),
+      .count = (this->count + lanes - 1) / lanes * lanes,
+    };
+  }
+
+  // xorshift32, good enough for scattering sparks
+  float ParticleSystem::random()
+  {
+    this->rng_ ^= this->rng_ << 13U;
+    this->rng_ ^= this->rng_ >> 17U;
+    this->rng_ ^= this->rng_ << 5U;
+    return static_cast<float>(this->rng_ >> 8U) * 0x1p-24F;
+  }
+}  //namespace kalika
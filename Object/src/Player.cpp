@@ -6,16 +6,6 @@
 namespace kalika
 {
 
-  namespace internal
-  {
-    sf::Texture& bullet_texture()
-    {
-      static sf::Texture t;
-      load_texture(t, "resources/bullet.png");
-      return t;
-    }
-  }  //namespace internal
-
   // ====== Player Functions ====== //
   // Constructor
   Player::Player(PlayerInfo info, EventBus* bus) :
@@ -23,11 +13,12 @@ namespace kalika
       info.position,
       info.velocity,
       info.dir,
-      info.player_tex,
+      info.player_sprite,
       info.size,
       bus
     ),
-    shoot(info.reticle_tex)
+    shoot(info.reticle_sprite),
+    fire_modes_{RapidFire(), SpreadFire(), ChaserFire()}
   {
     // Store magnitude of velocity
     this->vel_ = this->velocity().length();
@@ -43,11 +34,16 @@ namespace kalika
 
     // Update the frame of the ship
     this->update_frame();
+    this->prev_pos_ = this->position();
+    this->prev_offset_ = this->shoot.cur_offset;
   }
 
   // Move the player
   void Player::update(GameContext const& ctx, float dt)
   {
+    this->prev_pos_ = this->position();
+    this->prev_offset_ = this->shoot.cur_offset;
+
     // Transform the co-ordinate frame to the new position
     this->update_body(ctx, dt);
     this->update_reticle(dt);
@@ -87,11 +83,6 @@ namespace kalika
     this->shoot.cur_offset +=
       (target_offset - this->shoot.cur_offset) * this->shoot.resp * dt;
 
-    // Set reticle's position
-    this->shoot.sprite.setPosition(
-      this->position() + this->shoot.cur_offset
-    );
-
     // Set active state of the reticle
     if ((this->shoot.strength.lengthSquared() > 0.F)) {
       this->active_ = true;
@@ -104,14 +95,75 @@ namespace kalika
       this->active_ = false;
       this->shoot.reset_timer();
     }
+  }
+
+  // Render sync
+  void Player::sync_render(float alpha)
+  {
+    auto const pos =
+      this->prev_pos_ + ((this->position() - this->prev_pos_) * alpha);
+    this->sync_sprite(pos, this->forward());
+
+    // Set reticle's position
+    auto const offset =
+      this->prev_offset_ +
+      ((this->shoot.cur_offset - this->prev_offset_) * alpha);
+    auto const ret_pos = pos + offset;
+    if (ret_pos != this->shoot.sprite.getPosition()) {
+      this->shoot.sprite.setPosition(ret_pos);
+    }
 
     // Set reticle display on
-    if (this->active_) {
-      this->shoot.sprite.setColor(sf::Color::Cyan);
+    auto const colour =
+      this->active_ ? sf::Color::Cyan : sf::Color::Transparent;
+    if (colour != this->shoot.sprite.getColor()) {
+      this->shoot.sprite.setColor(colour);
     }
-    else {
-      this->shoot.sprite.setColor(sf::Color::Transparent);
+  }
+
+  // Copy out the simulation state
+  PlayerState Player::state() const
+  {
+    std::array<FireTimers, NUM_MODES> timers{};
+    for (size_t idx = 0; idx < NUM_MODES; idx++) {
+      timers[idx] = std::visit(
+        [](auto const& mode) { return mode.timers(); },
+        this->fire_modes_[idx]
+      );
+    }
+    return {
+      .mov = this->mov_,
+      .strength = this->strength,
+      .aim = this->shoot.strength,
+      .offset = this->shoot.cur_offset,
+      .reticle_elapsed = this->shoot.elapsed,
+      .active = this->active_,
+      .prev_pos = this->prev_pos_,
+      .prev_offset = this->prev_offset_,
+      .mode = this->mode_id_,
+      .fire_timers = timers,
+    };
+  }
+
+  // Take over a saved state
+  void Player::restore(PlayerState const& state)
+  {
+    this->mov_ = state.mov;
+    this->strength = state.strength;
+    this->shoot.strength = state.aim;
+    this->shoot.cur_offset = state.offset;
+    this->shoot.elapsed = state.reticle_elapsed;
+    this->active_ = state.active;
+    this->prev_pos_ = state.prev_pos;
+    this->prev_offset_ = state.prev_offset;
+    this->mode_id_ = state.mode;
+    for (size_t idx = 0; idx < NUM_MODES; idx++) {
+      std::visit(
+        [&](auto& mode) { mode.restore(state.fire_timers[idx]); },
+        this->fire_modes_[idx]
+      );
     }
+    this->draw_.synced = false;
   }
 
   // Bind position to world boundary
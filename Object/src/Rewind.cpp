@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+#include <Object/Rewind.hpp>
+
+namespace kalika
+{
+  namespace
+  {
+    /**
+     * @brief Section of a delta, followed by its runs
+     */
+    struct DeltaSection {
+      SnapshotSection kind;
+      std::uint32_t index;
+      std::uint32_t elem_size;
+      std::uint32_t runs;
+      std::uint64_t count;
+    };
+
+    /**
+     * @brief Changed bytes of a section, followed by the bytes
+     */
+    struct DeltaRun {
+      std::uint32_t offset;
+      std::uint32_t size;
+    };
+
+    // Bytes compared at once
+    constexpr size_t chunk = 8;
+    // A run header costs a chunk, so runs bridge a single unchanged one
+    constexpr size_t bridge = chunk;
+
+    template<typename T>
+    void put(std::vector<std::byte>& out, T const& value)
+    {
+      auto const at = out.size();
+      out.resize(at + sizeof(T));
+      std::memcpy(out.data() + at, &value, sizeof(T));
+    }
+
+    template<typename T> T take(std::span<std::byte const>& in)
+    {
+      T value;
+      std::memcpy(&value, in.data(), sizeof(T));
+      in = in.subspan(sizeof(T));
+      return value;
+    }
+
+    // Whole chunks compare as one word
+    bool same_chunk(
+      std::span<std::byte const> before,
+      std::span<std::byte const> after,
+      size_t at,
+      size_t size
+    )
+    {
+      if (size != chunk) {
+        return std::memcmp(before.data() + at, after.data() + at, size) ==
+               0;
+      }
+      std::uint64_t lhs = 0;
+      std::uint64_t rhs = 0;
+      std::memcpy(&lhs, before.data() + at, chunk);
+      std::memcpy(&rhs, after.data() + at, chunk);
+      return lhs == rhs;
+    }
+
+    // Append the runs of after that differ from before
+    std::uint32_t encode_runs(
+      std::vector<std::byte>& out,
+      std::span<std::byte const> before,
+      std::span<std::byte const> after
+    )
+    {
+      std::uint32_t runs = 0;
+      size_t start = 0;
+      size_t end = 0;
+      bool open = false;
+      auto const flush = [&] {
+        put(
+          out,
+          DeltaRun{
+            static_cast<std::uint32_t>(start),
+            static_cast<std::uint32_t>(end - start)
+          }
+        );
+        auto const at = out.size();
+        out.resize(at + (end - start));
+        std::memcpy(out.data() + at, after.data() + start, end - start);
+        runs++;
+      };
+
+      for (size_t at = 0; at < after.size(); at += chunk) {
+        size_t const size = std::min(chunk, after.size() - at);
+        // Bytes past the old end of the section are always new
+        bool const changed = at + size > before.size() ||
+                             !same_chunk(before, after, at, size);
+        if (!changed) {
+          continue;
+        }
+        if (open && at > end + bridge) {
+          flush();
+          open = false;
+        }
+        if (!open) {
+          start = at;
+          open = true;
+        }
+        end = at + size;
+      }
+      if (open) {
+        flush();
+      }
+      return runs;
+    }
+
+    // Delta of every section of after against the same section of
+    // before, if it has one
+    void encode(
+      std::vector<std::byte>& out,
+      SnapshotView const& before,
+      SnapshotView const& after
+    )
+    {
+      for (auto const& entry : after.entries()) {
+        auto const* old = before.find(entry.kind, entry.index);
+        auto const old_bytes = (old != nullptr)
+                                 ? before.bytes(*old)
+                                 : std::span<std::byte const>();
+
+        auto const head = out.size();
+        put(
+          out,
+          DeltaSection{
+            .kind = entry.kind,
+            .index = entry.index,
+            .elem_size = entry.elem_size,
+            .runs = 0,
+            .count = entry.count,
+          }
+        );
+        auto const runs = encode_runs(out, old_bytes, after.bytes(entry));
+        std::memcpy(
+          out.data() + head + offsetof(DeltaSection, runs),
+          &runs,
+          sizeof(runs)
+        );
+      }
+    }
+
+    // Check if a delta keeps every section of before where it is, so
+    // it can be applied in place
+    bool same_layout(
+      SnapshotView const& before, std::span<std::byte const> delta
+    )
+    {
+      auto const entries = before.entries();
+      size_t idx = 0;
+      while (!delta.empty()) {
+        auto const head = take<DeltaSection>(delta);
+        if (idx == entries.size() || entries[idx].kind != head.kind ||
+            entries[idx].index != head.index ||
+            entries[idx].elem_size != head.elem_size ||
+            entries[idx].count != head.count) {
+          return false;
+        }
+        for (std::uint32_t i = 0; i < head.runs; i++) {
+          delta = delta.subspan(take<DeltaRun>(delta).size);
+        }
+        idx++;
+      }
+      return idx == entries.size();
+    }
+
+    // Turn a state into the next one. Bullets spawned or released move
+    // sections around, and only then is the file laid out again.
+    void apply_delta(
+      std::vector<std::byte>& state,
+      std::span<std::byte const> delta,
+      SnapshotWriter& out,
+      std::vector<std::byte>& scratch
+    )
+    {
+      // Deltas only ever come from valid snapshots
+      auto const before = *SnapshotView::borrow(state);
+      bool const in_place = same_layout(before, delta);
+      out.clear();
+      size_t idx = 0;
+      while (!delta.empty()) {
+        auto const head = take<DeltaSection>(delta);
+        auto const* old = in_place ? &before.entries()[idx++]
+                                   : before.find(head.kind, head.index);
+        auto const old_bytes = (old != nullptr)
+                                 ? before.bytes(*old)
+                                 : std::span<std::byte const>();
+
+        std::span<std::byte> section;
+        if (in_place) {
+          section =
+            std::span(state).subspan(old->offset, old_bytes.size());
+        }
+        else {
+          scratch.assign(head.count * head.elem_size, std::byte{});
+          std::copy_n(
+            old_bytes.begin(),
+            std::min(old_bytes.size(), scratch.size()),
+            scratch.begin()
+          );
+          section = scratch;
+        }
+        for (std::uint32_t i = 0; i < head.runs; i++) {
+          auto const run = take<DeltaRun>(delta);
+          std::copy_n(
+            delta.begin(), run.size, section.begin() + run.offset
+          );
+          delta = delta.subspan(run.size);
+        }
+        if (!in_place) {
+          out.add_bytes(
+            head.kind, head.index, head.elem_size, head.count, section
+          );
+        }
+      }
+      if (!in_place) {
+        out.bytes(scratch);
+        state.swap(scratch);
+      }
+    }
+  }  //namespace
+
+  RewindBuffer::RewindBuffer(size_t budget, size_t keyframe_interval) :
+    budget_(budget), interval_(std::max<size_t>(keyframe_interval, 1))
+  {}
+
+  // Keyframe or delta against the tick before
+  bool
+  RewindBuffer::capture(std::uint64_t tick, std::vector<std::byte>& state)
+  {
+    auto const view = SnapshotView::borrow(state);
+    if (!view) {
+      return false;
+    }
+    bool const keyframe = this->last_.empty() || this->entries_.empty() ||
+                          tick != this->newest() + 1 ||
+                          this->since_keyframe_ + 1 >= this->interval_;
+
+    auto data = this->take_buffer();
+    if (keyframe) {
+      data.assign(state.begin(), state.end());
+      this->since_keyframe_ = 0;
+    }
+    else {
+      encode(data, *SnapshotView::borrow(this->last_), *view);
+      this->since_keyframe_++;
+    }
+
+    this->bytes_ += data.size();
+    this->entries_.push_back({tick, keyframe, std::move(data)});
+    this->last_.swap(state);
+    this->evict();
+    return true;
+  }
+
+  // Nearest keyframe, then every delta up to the tick
+  std::optional<SnapshotView> RewindBuffer::at(std::uint64_t tick) const
+  {
+    auto const found = std::ranges::lower_bound(
+      this->entries_, tick, {}, &Entry::tick
+    );
+    if (found == this->entries_.end() || found->tick != tick) {
+      return std::nullopt;
+    }
+    if (found->tick == this->newest() && !this->last_.empty()) {
+      return SnapshotView::from_bytes(this->last_);
+    }
+
+    auto key = found;
+    while (!key->keyframe) {
+      --key;
+    }
+    auto state = key->data;
+    SnapshotWriter out;
+    std::vector<std::byte> scratch;
+    for (auto it = key + 1; it <= found; ++it) {
+      apply_delta(state, it->data, out, scratch);
+    }
+    return SnapshotView::from_bytes(std::move(state));
+  }
+
+  // The next capture starts a keyframe
+  void RewindBuffer::truncate(std::uint64_t tick)
+  {
+    while (!this->entries_.empty() && this->newest() > tick) {
+      this->bytes_ -= this->entries_.back().data.size();
+      this->spare_.push_back(std::move(this->entries_.back().data));
+      this->entries_.pop_back();
+    }
+    this->last_.clear();
+  }
+
+  void RewindBuffer::clear()
+  {
+    for (auto& entry : this->entries_) {
+      this->spare_.push_back(std::move(entry.data));
+    }
+    this->entries_.clear();
+    this->bytes_ = 0;
+    this->last_.clear();
+  }
+
+  std::vector<std::byte> RewindBuffer::take_buffer()
+  {
+    if (this->spare_.empty()) {
+      return {};
+    }
+    auto data = std::move(this->spare_.back());
+    this->spare_.pop_back();
+    data.clear();
+    return data;
+  }
+
+  // Whole keyframe intervals go at once, the newest one never
+  void RewindBuffer::evict()
+  {
+    while (this->bytes_ > this->budget_) {
+      auto const next = std::find_if(
+        this->entries_.begin() + 1,
+        this->entries_.end(),
+        [](Entry const& entry) { return entry.keyframe; }
+      );
+      if (next == this->entries_.end()) {
+        return;
+      }
+      for (auto it = this->entries_.begin(); it != next; ++it) {
+        this->bytes_ -= it->data.size();
+        this->spare_.push_back(std::move(it->data));
+      }
+      this->entries_.erase(this->entries_.begin(), next);
+    }
+  }
+}  //namespace kalika
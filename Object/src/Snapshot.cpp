@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define KALIKA_SNAPSHOT_MMAP
+#endif
+
+#include <Object/Snapshot.hpp>
+
+namespace kalika
+{
+  namespace
+  {
+    size_t align_up(size_t value)
+    {
+      return (value + snapshot_align - 1) / snapshot_align *
+             snapshot_align;
+    }
+  }  //namespace
+
+  // ====== Writer ====== //
+  // Append a section to the payload
+  std::span<std::byte> SnapshotWriter::add_bytes(
+    SnapshotSection kind,
+    std::uint32_t index,
+    size_t elem_size,
+    size_t count,
+    std::span<std::byte const> data
+  )
+  {
+    size_t const offset = align_up(this->payload_.size());
+    this->payload_.resize(offset + data.size());
+    if (!data.empty()) {
+      std::memcpy(
+        this->payload_.data() + offset, data.data(), data.size()
+      );
+    }
+    this->entries_.push_back({
+      .kind = kind,
+      .index = index,
+      .elem_size = static_cast<std::uint32_t>(elem_size),
+      .reserved = 0,
+      .offset = offset,
+      .count = count,
+    });
+    return {this->payload_.data() + offset, data.size()};
+  }
+
+  void SnapshotWriter::clear()
+  {
+    this->entries_.clear();
+    this->payload_.clear();
+  }
+
+  std::vector<std::byte> SnapshotWriter::bytes() const
+  {
+    std::vector<std::byte> file;
+    this->bytes(file);
+    return file;
+  }
+
+  // Lay out header, table and payload
+  void SnapshotWriter::bytes(std::vector<std::byte>& file) const
+  {
+    size_t const table = sizeof(SnapshotHeader);
+    size_t const table_end =
+      table + (this->entries_.size() * sizeof(SnapshotEntry));
+    size_t const start = align_up(table_end);
+
+    SnapshotHeader header;
+    header.sections = static_cast<std::uint32_t>(this->entries_.size());
+    header.size = start + this->payload_.size();
+
+    // Only the padding after the table is not overwritten below
+    file.resize(header.size);
+    std::fill(
+      file.begin() + table_end, file.begin() + start, std::byte{}
+    );
+    std::memcpy(file.data(), &header, sizeof(header));
+    auto* entries = file.data() + table;
+    for (auto entry : this->entries_) {
+      entry.offset += start;
+      std::memcpy(entries, &entry, sizeof(entry));
+      entries += sizeof(entry);
+    }
+    if (!this->payload_.empty()) {
+      std::memcpy(
+        file.data() + start, this->payload_.data(), this->payload_.size()
+      );
+    }
+  }
+
+  bool SnapshotWriter::save(char const* path) const
+  {
+    auto const file = this->bytes();
+    std::ofstream out(path, std::ios::binary);
+    out.write(
+      reinterpret_cast<char const*>(file.data()),
+      static_cast<std::streamsize>(file.size())
+    );
+    return static_cast<bool>(out);
+  }
+
+  // ====== View ====== //
+  struct SnapshotView::Storage {
+    std::byte const* bytes = nullptr;
+    size_t size = 0;
+    // Bytes held in memory, if they are not mapped or borrowed
+    std::vector<std::byte> owned;
+    bool mapped = false;
+
+    Storage() = default;
+    Storage(Storage const&) = delete;
+    Storage& operator=(Storage const&) = delete;
+
+    ~Storage()
+    {
+#ifdef KALIKA_SNAPSHOT_MMAP
+      if (this->mapped) {
+        munmap(const_cast<std::byte*>(this->bytes), this->size);
+      }
+#endif
+    }
+  };
+
+  // Map the file read-only
+  std::optional<SnapshotView> SnapshotView::open(char const* path)
+  {
+#ifdef KALIKA_SNAPSHOT_MMAP
+    int const fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    struct stat info{};
+    void* map = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+      map = mmap(
+        nullptr,
+        static_cast<size_t>(info.st_size),
+        PROT_READ,
+        MAP_PRIVATE,
+        fd,
+        0
+      );
+    }
+    // The mapping outlives the descriptor
+    close(fd);
+    if (map == MAP_FAILED) {
+      return std::nullopt;
+    }
+
+    auto storage = std::make_shared<Storage>();
+    storage->bytes = static_cast<std::byte const*>(map);
+    storage->size = static_cast<size_t>(info.st_size);
+    storage->mapped = true;
+    return validate(std::move(storage));
+#else
+    // No mmap: read the file in one go
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+      return std::nullopt;
+    }
+    std::vector<std::byte> bytes(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(
+      reinterpret_cast<char*>(bytes.data()),
+      static_cast<std::streamsize>(bytes.size())
+    );
+    return in ? from_bytes(std::move(bytes)) : std::nullopt;
+#endif
+  }
+
+  std::optional<SnapshotView>
+  SnapshotView::from_bytes(std::vector<std::byte> bytes)
+  {
+    auto storage = std::make_shared<Storage>();
+    storage->owned = std::move(bytes);
+    storage->bytes = storage->owned.data();
+    storage->size = storage->owned.size();
+    return validate(std::move(storage));
+  }
+
+  std::optional<SnapshotView>
+  SnapshotView::borrow(std::span<std::byte const> bytes)
+  {
+    auto storage = std::make_shared<Storage>();
+    storage->bytes = bytes.data();
+    storage->size = bytes.size();
+    return validate(std::move(storage));
+  }
+
+  // Check everything the accessors rely on, once
+  std::optional<SnapshotView>
+  SnapshotView::validate(std::shared_ptr<Storage const> storage)
+  {
+    SnapshotHeader header;
+    SnapshotHeader const expected;
+    if (storage->size < sizeof(header)) {
+      return std::nullopt;
+    }
+    std::memcpy(&header, storage->bytes, sizeof(header));
+    size_t const table_end =
+      sizeof(header) + (header.sections * sizeof(SnapshotEntry));
+    if (header.magic != expected.magic ||
+        header.version != SnapshotHeader::current_version ||
+        header.order != SnapshotHeader::byte_order ||
+        header.size != storage->size || table_end > storage->size) {
+      return std::nullopt;
+    }
+
+    SnapshotView view(std::move(storage));
+    for (auto const& entry : view.entries()) {
+      // Divide rather than multiply, so a bad count cannot overflow
+      bool const inside =
+        entry.elem_size > 0 && entry.offset >= table_end &&
+        entry.offset <= header.size &&
+        entry.count <= (header.size - entry.offset) / entry.elem_size;
+      if (entry.offset % snapshot_align != 0 || !inside) {
+        return std::nullopt;
+      }
+    }
+    return view;
+  }
+
+  size_t SnapshotView::size() const
+  {
+    return this->storage_->size;
+  }
+
+  std::byte const* SnapshotView::data() const
+  {
+    return this->storage_->bytes;
+  }
+
+  std::span<SnapshotEntry const> SnapshotView::entries() const
+  {
+    SnapshotHeader header;
+    std::memcpy(&header, this->data(), sizeof(header));
+    auto const* first = this->data() + sizeof(header);
+    return {
+      reinterpret_cast<SnapshotEntry const*>(first), header.sections
+    };
+  }
+
+  // Sections are few, so a scan is enough
+  SnapshotEntry const*
+  SnapshotView::find(SnapshotSection kind, std::uint32_t index) const
+  {
+    for (auto const& entry : this->entries()) {
+      if (entry.kind == kind && entry.index == index) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+}  //namespace kalika
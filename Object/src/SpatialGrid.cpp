@@ -0,0 +1,144 @@
+#include <cmath>
+
+#include <Object/SpatialGrid.hpp>
+
+namespace kalika
+{
+  // Place the grid
+  void SpatialGrid::reset(sf::FloatRect bounds, float cell_size)
+  {
+    // Coarser cells for huge bounds, so the grid stays small
+    float const widest = std::max(bounds.size.x, bounds.size.y);
+    cell_size = std::max(cell_size, widest / max_axis_cells);
+
+    this->left_ = bounds.position.x;
+    this->top_ = bounds.position.y;
+    this->cell_size_ = cell_size;
+    this->inv_cell_ = 1.F / cell_size;
+
+    auto const cells = [cell_size](float extent) {
+      return std::max(
+        1U, static_cast<std::uint32_t>(std::ceil(extent / cell_size))
+      );
+    };
+    this->cols_ = cells(bounds.size.x);
+    this->rows_ = cells(bounds.size.y);
+    this->start_.assign(this->cell_count() + 1, 0U);
+    this->entries_.clear();
+    this->count_ = 0;
+  }
+
+  // Counting sort of the circles by cell
+  void SpatialGrid::build(
+    std::span<float const> xs,
+    std::span<float const> ys,
+    std::span<float const> radii
+  )
+  {
+    auto const count = static_cast<std::uint32_t>(xs.size());
+    auto const cell_count = this->cell_count();
+    this->count_ = count;
+    this->start_.assign(cell_count + 1, 0U);
+
+    // Call func(cell) for every cell the bounding square of i overlaps
+    auto const for_cells = [&](std::uint32_t i, auto&& func) {
+      auto const [col0, row0] =
+        this->cell_coords(xs[i] - radii[i], ys[i] - radii[i]);
+      auto const [col1, row1] =
+        this->cell_coords(xs[i] + radii[i], ys[i] + radii[i]);
+      for (auto row = row0; row <= row1; row++) {
+        for (auto col = col0; col <= col1; col++) {
+          func((row * this->cols_) + col);
+        }
+      }
+    };
+
+    // 1. Count the circles of every cell
+    for (std::uint32_t i = 0; i < count; i++) {
+      for_cells(i, [this](std::uint32_t cell) {
+        this->start_[cell + 1]++;
+      });
+    }
+
+    // 2. Prefix sum into the end of every cell
+    for (size_t cell = 1; cell <= cell_count; cell++) {
+      this->start_[cell] += this->start_[cell - 1];
+    }
+
+    // 3. Scatter, filling each cell from its back so circles keep their
+    // input order within a cell
+    this->entries_.resize(this->start_[cell_count]);
+    for (std::uint32_t i = count; i-- > 0;) {
+      Entry const entry = {xs[i], ys[i], radii[i], i};
+      for_cells(i, [&](std::uint32_t cell) {
+        this->entries_[--this->start_[cell + 1]] = entry;
+      });
+    }
+
+    // The end of every cell moved down to its first slot
+    for (size_t cell = 0; cell < cell_count; cell++) {
+      this->start_[cell] = this->start_[cell + 1];
+    }
+    this->start_[cell_count] =
+      static_cast<std::uint32_t>(this->entries_.size());
+  }
+
+  // Ring search around the cell of the point
+  SpatialGrid::Entry const*
+  SpatialGrid::nearest(float x, float y, float radius) const
+  {
+    if (this->empty()) {
+      return nullptr;
+    }
+
+    Entry const* best = nullptr;
+    float best_sq = radius * radius;
+    auto const visit = [&](std::int64_t col, std::int64_t row) {
+      if (col < 0 || row < 0 || col >= this->cols_ || row >= this->rows_) {
+        return;
+      }
+      auto const cell = (row * this->cols_) + col;
+      auto const end = this->start_[cell + 1];
+      for (auto k = this->start_[cell]; k < end; k++) {
+        auto const& entry = this->entries_[k];
+        float const dx = entry.x - x;
+        float const dy = entry.y - y;
+        float const dist_sq = (dx * dx) + (dy * dy);
+        bool const tie = best != nullptr && dist_sq == best_sq &&
+                         entry.id < best->id;
+        bool const closer =
+          (best == nullptr) ? dist_sq <= best_sq : dist_sq < best_sq;
+        if (closer || tie) {
+          best = &entry;
+          best_sq = dist_sq;
+        }
+      }
+    };
+
+    // A centre in ring k + 1 is at least k cells away
+    auto const [c, r] = this->cell_coords(x, y);
+    std::int64_t const col = c;
+    std::int64_t const row = r;
+    auto const rings = std::min<std::int64_t>(
+      static_cast<std::int64_t>(radius * this->inv_cell_) + 1,
+      std::max(this->cols_, this->rows_)
+    );
+
+    visit(col, row);
+    for (std::int64_t ring = 1; ring <= rings; ring++) {
+      float const reach = static_cast<float>(ring - 1) * this->cell_size_;
+      if (best != nullptr && best_sq <= reach * reach) {
+        break;
+      }
+      for (auto i = col - ring; i <= col + ring; i++) {
+        visit(i, row - ring);
+        visit(i, row + ring);
+      }
+      for (auto i = row - ring + 1; i < row + ring; i++) {
+        visit(col - ring, i);
+        visit(col + ring, i);
+      }
+    }
+    return best;
+  }
+}  //namespace kalika
@@ -0,0 +1,77 @@
+#include <Object/Targeting.hpp>
+#include <Profile/Profiler.hpp>
+
+namespace kalika
+{
+  // Refresh the targets of a store
+  TargetStats assign_targets(
+    internal::Kinematics& kin,
+    SpatialGrid const& grid,
+    Colliders const& enemies,
+    float range,
+    size_t tick
+  )
+  {
+    return assign_targets(
+      kin, grid, enemies, range, tick, 0, kin.size()
+    );
+  }
+
+  // Refresh the targets of a range
+  TargetStats assign_targets(
+    internal::Kinematics& kin,
+    SpatialGrid const& grid,
+    Colliders const& enemies,
+    float range,
+    size_t tick,
+    size_t begin,
+    size_t end
+  )
+  {
+    KALIKA_PROFILE_SCOPE("targeting");
+    TargetStats stats;
+    float const range_sq = range * range;
+
+    for (size_t idx = begin; idx < end; idx++) {
+      float const px = kin.px[idx];
+      float const py = kin.py[idx];
+      Handle& target = kin.target[idx];
+
+      // Keep a live target that is still in range
+      if (target.idx != npos) {
+        slot_id const slot = enemies.find(target);
+        if (slot != npos) {
+          float const dx = enemies.x[slot] - px;
+          float const dy = enemies.y[slot] - py;
+          if ((dx * dx) + (dy * dy) <= range_sq) {
+            kin.tx[idx] = enemies.x[slot];
+            kin.ty[idx] = enemies.y[slot];
+            stats.kept++;
+            continue;
+          }
+        }
+        // Lost it: search straight away
+        target = {};
+      }
+      else if ((idx + tick) % retarget_interval != 0) {
+        kin.tx[idx] = px;
+        kin.ty[idx] = py;
+        continue;
+      }
+
+      stats.searched++;
+      auto const* entry = grid.nearest(px, py, range);
+      if (entry != nullptr) {
+        target = enemies.owner[entry->id];
+        kin.tx[idx] = entry->x;
+        kin.ty[idx] = entry->y;
+        stats.found++;
+      }
+      else {
+        kin.tx[idx] = px;
+        kin.ty[idx] = py;
+      }
+    }
+    return stats;
+  }
+}  //namespace kalika
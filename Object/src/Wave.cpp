@@ -0,0 +1,212 @@
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <Object/Wave.hpp>
+
+namespace kalika
+{
+  namespace
+  {
+    // Fields of a group line
+    constexpr size_t group_fields = 12;
+
+    // Parse a whole token as a number
+    template<typename T> bool parse(std::string_view token, T& value)
+    {
+      auto const* end = token.data() + token.size();
+      auto const [ptr, ec] = std::from_chars(token.data(), end, value);
+      return ec == std::errc{} && ptr == end;
+    }
+
+    // Split a line on whitespace, up to the first comment. Returns the
+    // number of tokens, or one more than fits when the line is too long.
+    size_t split(
+      std::string_view line,
+      std::array<std::string_view, group_fields>& tokens
+    )
+    {
+      line = line.substr(0, line.find('#'));
+      size_t count = 0;
+      size_t pos = line.find_first_not_of(" \t\r");
+      while (pos != std::string_view::npos) {
+        size_t const end = line.find_first_of(" \t\r", pos);
+        if (count == tokens.size()) {
+          return count + 1;
+        }
+        tokens[count++] = line.substr(pos, end - pos);
+        pos = line.find_first_not_of(" \t\r", end);
+      }
+      return count;
+    }
+
+    // Most enemies alive at once, sweeping spawns and expiries in time
+    // order. Spawns go first on ties, which never undercounts.
+    size_t peak_alive(std::vector<WaveSpawn> const& spawns)
+    {
+      std::vector<std::pair<float, int>> changes;
+      changes.reserve(spawns.size() * 2);
+      for (auto const& spawn : spawns) {
+        changes.emplace_back(spawn.time, 1);
+        if (spawn.lifetime >= 0.F) {
+          changes.emplace_back(spawn.time + spawn.lifetime, -1);
+        }
+      }
+      std::ranges::sort(changes, [](auto const& a, auto const& b) {
+        return a.first < b.first ||
+               (a.first == b.first && a.second > b.second);
+      });
+
+      size_t alive = 0;
+      size_t peak = 0;
+      for (auto const& [time, change] : changes) {
+        alive = (change > 0) ? alive + 1 : alive - 1;
+        peak = std::max(peak, alive);
+      }
+      return peak;
+    }
+  }  //namespace
+
+  // Expand the groups of a wave file
+  std::optional<Wave> parse_wave(std::string_view text, size_t* error_line)
+  {
+    Wave wave;
+    bool has_end = false;
+    std::array<std::string_view, group_fields> tok;
+
+    size_t line_no = 0;
+    while (!text.empty()) {
+      line_no++;
+      size_t const eol = text.find('\n');
+      std::string_view const line = text.substr(0, eol);
+      text = (eol == std::string_view::npos) ? "" : text.substr(eol + 1);
+
+      auto const count = split(line, tok);
+      if (count == 0) {
+        continue;
+      }
+
+      bool ok = false;
+      if (count == 2 && tok[0] == "end") {
+        ok = parse(tok[1], wave.duration) && wave.duration >= 0.F;
+        has_end = true;
+      }
+      else if (count == group_fields) {
+        float time = 0.F;
+        size_t enemies = 0;
+        float every = 0.F;
+        float x = 0.F;
+        float y = 0.F;
+        float dx = 0.F;
+        float dy = 0.F;
+        WaveSpawn spawn{};
+        spawn.behaviour = find_behaviour(tok[1]);
+        ok = parse(tok[0], time) && spawn.behaviour != no_behaviour &&
+             parse(tok[2], enemies) && parse(tok[3], every) &&
+             parse(tok[4], x) && parse(tok[5], y) &&
+             parse(tok[6], dx) && parse(tok[7], dy) &&
+             parse(tok[8], spawn.vx) && parse(tok[9], spawn.vy) &&
+             parse(tok[10], spawn.health) &&
+             parse(tok[11], spawn.lifetime) && time >= 0.F &&
+             every >= 0.F;
+        for (size_t i = 0; ok && i < enemies; i++) {
+          auto const step = static_cast<float>(i);
+          spawn.time = time + (step * every);
+          spawn.x = x + (step * dx);
+          spawn.y = y + (step * dy);
+          wave.spawns.push_back(spawn);
+        }
+      }
+
+      if (!ok) {
+        if (error_line != nullptr) {
+          *error_line = line_no;
+        }
+        return std::nullopt;
+      }
+    }
+
+    // Groups may interleave; equal times keep the file order
+    std::ranges::stable_sort(wave.spawns, {}, &WaveSpawn::time);
+    if (!has_end && !wave.spawns.empty()) {
+      wave.duration = wave.spawns.back().time;
+    }
+    wave.peak = peak_alive(wave.spawns);
+    return wave;
+  }
+
+  // Read a wave file
+  std::optional<Wave> load_wave(char const* path, size_t* error_line)
+  {
+    std::ifstream file(path);
+    if (!file) {
+      if (error_line != nullptr) {
+        *error_line = 0;
+      }
+      return std::nullopt;
+    }
+    std::string const text{
+      std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>()
+    };
+    return parse_wave(text, error_line);
+  }
+
+  // Constructor
+  WaveScheduler::WaveScheduler(Wave wave, bool loop) :
+    wave_(std::move(wave)), loop_(loop)
+  {
+    for_each_behaviour([this]<typename B>() {
+      auto& proto = this->prototypes_[behaviour_id<B>];
+      proto.sprite = B::sprite;
+      proto.behaviour_id = behaviour_id<B>;
+      proto.frame_count = B::frame_count;
+      proto.interval = B::interval;
+    });
+    // A tick never spawns more than the peak, so batches never grow
+    this->batch_.reserve(this->wave_.peak);
+  }
+
+  // Publish the spawns that came due
+  size_t WaveScheduler::advance(
+    float dt, sf::FloatRect bounds, EventBus& bus
+  )
+  {
+    auto const& spawns = this->wave_.spawns;
+    this->elapsed_ += dt;
+    this->batch_.clear();
+
+    while (true) {
+      while (this->cursor_ < spawns.size() &&
+             spawns[this->cursor_].time <= this->elapsed_) {
+        auto const& spawn = spawns[this->cursor_++];
+        auto event = this->prototypes_[spawn.behaviour];
+        event.position = {
+          bounds.position.x + (spawn.x * bounds.size.x),
+          bounds.position.y + (spawn.y * bounds.size.y),
+        };
+        event.velocity = {spawn.vx, spawn.vy};
+        event.health = spawn.health;
+        event.lifetime = spawn.lifetime;
+        this->batch_.push_back(event);
+      }
+
+      // Start the next pass once this one is over
+      bool const over = this->cursor_ == spawns.size() &&
+                        this->elapsed_ >= this->wave_.duration;
+      if (!this->loop_ || spawns.empty() || !over ||
+          this->wave_.duration <= 0.F) {
+        break;
+      }
+      this->elapsed_ -= this->wave_.duration;
+      this->cursor_ = 0;
+      this->pass_++;
+    }
+
+    bus.emplace_range(this->batch_);
+    return this->batch_.size();
+  }
+}  //namespace kalika
@@ -1,41 +1,635 @@
 #include <algorithm>
+#include <cmath>
+#include <format>
+#include <ranges>
+#include <span>
+#include <vector>
 
+#include <Object/Targeting.hpp>
 #include <Object/World.hpp>
+#include <Profile/Profiler.hpp>
 
 namespace kalika
 {
+  namespace
+  {
+    // FNV-1a over the bytes of a value
+    struct Fnv {
+      std::uint64_t hash = 14695981039346656037ULL;
+
+      template<typename T> void add(T const& value)
+      {
+        auto const* bytes = reinterpret_cast<unsigned char const*>(&value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+          this->hash = (this->hash ^ bytes[i]) * 1099511628211ULL;
+        }
+      }
+    };
+
+    // Partition of a bullet. Unknown behaviours fly straight, with no
+    // acceleration, as they did before bullets were partitioned.
+    BehaviourId partition_id(BehaviourId id)
+    {
+      return (id < behaviour_count) ? id : behaviour_id<Dasher>;
+    }
+
+    // Index of a kinematics column section
+    std::uint32_t column_index(BehaviourId id, std::uint32_t column)
+    {
+      return (static_cast<std::uint32_t>(id) << 8U) | column;
+    }
+
+    // Handle bookkeeping of a pool
+    template<typename Object>
+    void write_pool(
+      SnapshotWriter& out, Pool<Object> const& pool, std::uint32_t index
+    )
+    {
+      out.add(SnapshotSection::PoolOwners, index, pool.owners());
+      out.add(SnapshotSection::PoolEntries, index, pool.entries());
+      out.add(SnapshotSection::PoolFreeHead, index, pool.free_head());
+    }
+
+    // Rebuild a pool from its bookkeeping and one argument per object
+    template<typename Object, typename Arg, typename... Shared>
+    bool read_pool(
+      SnapshotView const& in,
+      Pool<Object>& pool,
+      std::uint32_t index,
+      std::span<Arg const> args,
+      Shared const&... shared
+    )
+    {
+      using Sparse = typename Pool<Object>::Sparse;
+      auto const owners =
+        in.section<slot_id>(SnapshotSection::PoolOwners, index);
+      auto const entries =
+        in.section<Sparse>(SnapshotSection::PoolEntries, index);
+      auto const* free_head =
+        in.single<slot_id>(SnapshotSection::PoolFreeHead, index);
+      return owners && entries && free_head != nullptr &&
+             pool.restore(args, *owners, *entries, *free_head, shared...);
+    }
+  }  //namespace
+
   // Update the state of objects
   void World::update(GameContext const& ctx, float dt)
   {
     // Update player
-    this->player.update(ctx, dt);
-    if (this->player.shoot.strength.lengthSquared() > 0) {
-      this->player.fire(ctx, dt);
+    {
+      KALIKA_PROFILE_SCOPE("player");
+      this->player.update(ctx, dt);
+      if (this->player.shoot.strength.lengthSquared() > 0) {
+        this->player.fire(ctx, dt);
+      }
+    }
+
+    internal::StepParams const params{
+      .dt = dt,
+      .left = ctx.world_size.position.x,
+      .top = ctx.world_size.position.y,
+      .width = ctx.world_size.size.x,
+      .height = ctx.world_size.size.y,
+    };
+
+    this->update_enemies(ctx, dt);
+
+    // Enemies are bucketed once per tick, for targeting and collisions
+    this->collisions_.reset(ctx.world_size, cell_size, bul_size / 2.F);
+    this->collisions_.begin(
+      this->enemy_colliders_, this->player.position(), this->player_radius_
+    );
+
+    // Every partition runs the kernel of its own motion model, in
+    // chunks spread over the job system. Objects never read each other,
+    // so the result does not depend on the number of threads.
+    for_each_behaviour([&]<typename B>() {
+      auto& part = this->partitions_[behaviour_id<B>];
+      auto const chunk = [&](size_t, size_t begin, size_t end) {
+        part.kin.save_positions(begin, end);
+        if constexpr (B::motion == internal::Motion::Homing) {
+          assign_targets(
+            part.kin,
+            this->collisions_.grid(),
+            this->enemy_colliders_,
+            B::range,
+            ctx.frame_count,
+            begin,
+            end
+          );
+        }
+        KALIKA_PROFILE_SCOPE("integrate");
+        internal::integrate(part.kin, params, B::motion, begin, end);
+      };
+      this->jobs_->parallel_for(part.kin.size(), chunk_size, chunk);
+
+      // Dead bullets go back to the pool straight away, which moves the
+      // last live bullet into the freed slot.
+      KALIKA_PROFILE_SCOPE("release");
+      for (slot_id idx = 0; idx < part.bullets.size();) {
+        if (part.kin.is_alive(idx)) {
+          idx++;
+        }
+        else {
+          part.bullets.release_at(idx);
+          part.kin.swap_remove(idx);
+        }
+      }
+    });
+
+    this->collide();
+
+    // Pure decoration: nothing in the simulation reads particles back
+    KALIKA_PROFILE_SCOPE("particles");
+    this->particles_.emit(this->bursts_);
+    this->bursts_.clear();
+    this->particles_.update(dt);
+  }
+
+  // Move enemies
+  void World::update_enemies(GameContext const& ctx, float dt)
+  {
+    KALIKA_PROFILE_SCOPE("enemies");
+
+    // Chasers steer towards the player
+    internal::Movable target;
+    target.pos = this->player.position();
+    for (auto& enemy : this->enemies_) {
+      enemy.update(ctx, target, dt);
     }
+    this->enemies_.release_if([](Enemy const& enemy) {
+      return !enemy.is_alive();
+    });
 
-    // Update bullets
-    for (auto& bullet : bullets_) {
-      bullet->update(ctx, dt);
-      if (!bullet->is_alive()) {
-        bus->emplace(GameEvent::ReleaseEvent{bullet.idx});
+    // Most ticks no strip changes frame, and nothing is touched
+    this->animation_.step();
+    if (this->animation_.any_changed()) {
+      for (auto& enemy : this->enemies_) {
+        enemy.animate(this->animation_);
       }
     }
 
-    // Update current cache
-    std::erase_if(this->bullets_, [](auto& bullet) {
-      return !bullet->is_alive();
+    auto& colliders = this->enemy_colliders_;
+    colliders.clear();
+    for (slot_id idx = 0; idx < this->enemies_.size(); idx++) {
+      auto const& enemy = this->enemies_[idx];
+      colliders.push(
+        enemy.position(), enemy.radius(), this->enemies_.handle(idx)
+      );
+    }
+  }
+
+  // Collision pass over the enemies bucketed at the start of the tick
+  void World::collide()
+  {
+    // Without enemies there is nothing a bullet or the player can hit
+    if (this->enemy_colliders_.size() == 0) {
+      return;
+    }
+
+    auto& coll = this->collisions_;
+    for (BehaviourId id = 0; id < behaviour_count; id++) {
+      auto const& part = this->partitions_[id];
+      auto const count = part.bullets.size();
+      coll.add_bullets(
+        id,
+        std::span(part.kin.px.data(), count),
+        std::span(part.kin.py.data(), count),
+        *this->jobs_,
+        chunk_size
+      );
+    }
+
+    // Handles outlive this tick's swap-removes
+    this->hits_.clear();
+    auto const& enemies = this->enemy_colliders_;
+    for (auto const& contact : coll.contacts()) {
+      auto const& bullets = this->partitions_[contact.behaviour].bullets;
+      Handle const bullet = bullets.handle(contact.bullet);
+      Handle const enemy = enemies.owner[contact.enemy];
+      this->hits_.push_back({
+        .kind = GameEvent::HitEvent::Kind::BulletEnemy,
+        .behaviour = contact.behaviour,
+        .idx = bullet.idx,
+        .gen = bullet.gen,
+        .target_idx = enemy.idx,
+        .target_gen = enemy.gen,
+        .damage = bul_damage,
+      });
+    }
+
+    // Rams stay in coll.player_hits(): the player takes no damage, so
+    // publishing them would only load the bus every tick
+    this->bus->emplace_range(this->hits_);
+  }
+
+  // Write transforms to sprites
+  void World::sync_render(float alpha)
+  {
+    KALIKA_PROFILE_SCOPE("sync_render");
+    this->player.sync_render(alpha);
+    for (auto& enemy : this->enemies_) {
+      enemy.sync_render(alpha);
+    }
+
+    for (auto& part : this->partitions_) {
+      auto const& kin = part.kin;
+      for (slot_id idx = 0; idx < part.bullets.size(); idx++) {
+        sf::Vector2f const pos = {
+          kin.ox[idx] + ((kin.px[idx] - kin.ox[idx]) * alpha),
+          kin.oy[idx] + ((kin.py[idx] - kin.oy[idx]) * alpha),
+        };
+        part.bullets[idx].sync_sprite(pos, {kin.dx[idx], kin.dy[idx]});
+      }
+    }
+  }
+
+  // Spawn a bullet
+  BulletHandle World::add_bullet(GameEvent::FireEvent const& event)
+  {
+    BehaviourId const id = partition_id(event.behaviour_id);
+    auto& part = this->partitions_[id];
+    Handle const handle = part.bullets.acquire(event);
+
+    // The pool appends at the end of the dense array, as does the store
+    part.kin.push(
+      event.position.x,
+      event.position.y,
+      event.velocity.x,
+      event.velocity.y,
+      event.lifetime,
+      homing_factor(id)
+    );
+    return {id, handle};
+  }
+
+  // Spawn a batch of bullets
+  void World::add_bullets(std::span<GameEvent::FireEvent const> events)
+  {
+    // Emitters batch bullets of one behaviour together, so runs are long
+    for (size_t begin = 0; begin < events.size();) {
+      BehaviourId const id = events[begin].behaviour_id;
+      size_t end = begin + 1;
+      while (end < events.size() && events[end].behaviour_id == id) {
+        end++;
+      }
+      auto const run = events.subspan(begin, end - begin);
+      begin = end;
+
+      auto& part = this->partitions_[partition_id(id)];
+      part.bullets.acquire_bulk(run);
+      size_t const start = part.kin.extend(run.size());
+
+      // Both stores append, so the batch lines up
+      float const homing = homing_factor(partition_id(id));
+      for (size_t i = 0; i < run.size(); i++) {
+        auto const& event = run[i];
+        part.kin.set(
+          start + i,
+          event.position.x,
+          event.position.y,
+          event.velocity.x,
+          event.velocity.y,
+          event.lifetime,
+          homing
+        );
+      }
+    }
+  }
+
+  // Expand a burst pattern
+  void World::add_burst(GameEvent::BurstEvent const& burst)
+  {
+    this->burst_.clear();
+
+    // Step the direction by a fixed rotation instead of per-bullet trig
+    sf::Vector2f dir = burst.forward.rotatedBy(burst.start);
+    sf::Vector2f const turn = {
+      std::cos(burst.step.asRadians()), std::sin(burst.step.asRadians())
+    };
+    for (std::uint32_t i = 0; i < burst.count; i++) {
+      this->burst_.push_back({
+        .position = burst.origin + (dir * burst.radius),
+        .velocity = dir * burst.speed,
+        .sprite = burst.sprite,
+        .size = burst.size,
+        .behaviour_id = burst.behaviour_id,
+        .lifetime = burst.lifetime,
+      });
+      dir = {
+        (dir.x * turn.x) - (dir.y * turn.y),
+        (dir.x * turn.y) + (dir.y * turn.x),
+      };
+    }
+
+    this->add_bullets(this->burst_);
+  }
+
+  // Spawn a batch of enemies
+  void World::add_enemies(std::span<GameEvent::SpawnEvent const> events)
+  {
+    slot_id const first = this->enemies_.acquire_bulk(events, this->bus);
+    for (slot_id idx = first; idx < this->enemies_.size(); idx++) {
+      this->enemies_[idx].join(this->animation_);
+    }
+  }
+
+  // Damage an enemy
+  bool World::damage_enemy(Handle handle, float damage)
+  {
+    slot_id const idx = this->enemies_.dense_index(handle);
+    if (idx == npos || !this->enemies_[idx].damage(damage)) {
+      return false;
+    }
+    auto const& enemy = this->enemies_[idx];
+    this->bursts_.push_back({
+      .position = enemy.position(),
+      .velocity = enemy.velocity(),
+      .strength = enemy.radius() * 2.F,
+      .kind = ParticleKind::Debris,
     });
+    this->enemies_.release_at(idx);
+    return true;
+  }
+
+  // Sparks start where the bullet is now
+  void World::hit_effects(std::span<GameEvent::HitEvent const> events)
+  {
+    for (auto const& event : events) {
+      if (event.kind != GameEvent::HitEvent::Kind::BulletEnemy ||
+          event.behaviour >= behaviour_count) {
+        continue;
+      }
+      auto const& part = this->partitions_[event.behaviour];
+      slot_id const idx =
+        part.bullets.dense_index({event.idx, event.gen});
+      if (idx == npos) {
+        continue;
+      }
+      this->bursts_.push_back({
+        .position = {part.kin.px[idx], part.kin.py[idx]},
+        .velocity = {},
+        .strength = event.damage,
+        .kind = ParticleKind::Spark,
+      });
+    }
+  }
+
+  // Pre-build enemies
+  void World::reserve_enemies(size_t count)
+  {
+    // The prototype is rebuilt on spawn; any sheet will do
+    GameEvent::SpawnEvent const proto{
+      .position = {},
+      .velocity = {},
+      .sprite = SpriteId::Dasher,
+      .behaviour_id = behaviour_id<Dasher>,
+    };
+    this->enemies_.prewarm(count, proto, this->bus);
+  }
+
+  // Release a bullet
+  bool World::release_bullet(BulletHandle handle)
+  {
+    if (handle.behaviour >= behaviour_count) {
+      return false;
+    }
+    auto& part = this->partitions_[handle.behaviour];
+    slot_id const idx = part.bullets.dense_index(handle.handle);
+    if (idx == npos) {
+      return false;
+    }
+
+    part.bullets.release_at(idx);
+    part.kin.swap_remove(idx);
+    return true;
   }
 
   std::vector<World::SpriteRef> World::sprites() const
   {
     std::vector<SpriteRef> container;
+    container.reserve(this->bullet_count() + this->enemy_count() + 2);
     container.emplace_back(player.sprite());
     container.emplace_back(player.reticle_sprite());
-    for (auto const& bullet : this->bullets_) {
-      container.emplace_back(bullet->sprite());
+    for (auto const& enemy : this->enemies_) {
+      container.emplace_back(enemy.sprite());
+    }
+    for (auto const& part : this->partitions_) {
+      for (auto const& bullet : part.bullets) {
+        container.emplace_back(bullet.sprite());
+      }
     }
 
     return container;
   }
+
+  // Live bullets over every partition
+  size_t World::bullet_count() const
+  {
+    size_t count = 0;
+    for (auto const& part : this->partitions_) {
+      count += part.bullets.size();
+    }
+    return count;
+  }
+
+  size_t World::bullet_capacity() const
+  {
+    size_t count = 0;
+    for (auto const& part : this->partitions_) {
+      count += part.bullets.capacity();
+    }
+    return count;
+  }
+
+  // Per-entity and allocated bytes of every kind
+  std::vector<MemoryStats> World::memory_stats() const
+  {
+    std::vector<MemoryStats> stats;
+    for_each_behaviour([&]<typename B>() {
+      auto const& part = this->partitions_[behaviour_id<B>];
+      auto const kin = internal::Kinematics::footprint(B::motion);
+      stats.push_back({
+        .name = std::format("{} bullets", B::name),
+        .live = part.bullets.size(),
+        .slots = part.bullets.capacity(),
+        .hot_bytes = kin.hot,
+        .cold_bytes = kin.cold + sizeof(Bullet) +
+                      Pool<Bullet>::slot_overhead(),
+        .total_bytes =
+          part.kin.allocated_bytes() + part.bullets.allocated_bytes(),
+      });
+    });
+
+    // Enemies are whole objects; only the sprite stays cold
+    stats.push_back({
+      .name = "enemies",
+      .live = this->enemies_.size(),
+      .slots = this->enemies_.capacity(),
+      .hot_bytes = sizeof(Enemy) - sizeof(internal::Drawable),
+      .cold_bytes =
+        sizeof(internal::Drawable) + Pool<Enemy>::slot_overhead(),
+      .total_bytes = this->enemies_.allocated_bytes(),
+    });
+
+    // Particles are stepped whole; nothing about them is cold
+    stats.push_back({
+      .name = "particles",
+      .live = this->particles_.size(),
+      .slots = this->particles_.capacity() * particle_kinds,
+      .hot_bytes = ParticleSystem::particle_bytes,
+      .cold_bytes = 0,
+      .total_bytes = this->particles_.allocated_bytes(),
+    });
+    return stats;
+  }
+
+  // Hash everything a replay must reproduce
+  std::uint64_t World::digest() const
+  {
+    Fnv fnv;
+    fnv.add(this->player.position());
+    fnv.add(this->player.velocity());
+    for (auto const& part : this->partitions_) {
+      auto const& kin = part.kin;
+      fnv.add(kin.size());
+      for (size_t idx = 0; idx < kin.size(); idx++) {
+        fnv.add(kin.px[idx]);
+        fnv.add(kin.py[idx]);
+        fnv.add(kin.vx[idx]);
+        fnv.add(kin.vy[idx]);
+        fnv.add(kin.life[idx]);
+      }
+    }
+    fnv.add(this->enemies_.size());
+    for (auto const& enemy : this->enemies_) {
+      fnv.add(enemy.position());
+      fnv.add(enemy.velocity());
+      fnv.add(enemy.health());
+    }
+    return fnv.hash;
+  }
+
+  // Flat sections of everything but the events in flight
+  void World::write_snapshot(SnapshotWriter& out) const
+  {
+    out.add(SnapshotSection::Player, 0, this->player.state());
+
+    std::vector<BulletLook> looks;
+    for (BehaviourId id = 0; id < behaviour_count; id++) {
+      auto const& part = this->partitions_[id];
+      std::uint32_t column = 0;
+      part.kin.for_each_column([&](auto const& values) {
+        out.add(
+          SnapshotSection::BulletColumn,
+          column_index(id, column++),
+          std::span(values.data(), part.kin.size())
+        );
+      });
+
+      looks.clear();
+      for (auto const& bullet : part.bullets) {
+        looks.push_back(bullet.look());
+      }
+      out.add(
+        SnapshotSection::BulletLooks,
+        id,
+        std::span<BulletLook const>(looks)
+      );
+      write_pool(out, part.bullets, id);
+    }
+
+    std::vector<EnemyState> enemies;
+    enemies.reserve(this->enemies_.size());
+    for (auto const& enemy : this->enemies_) {
+      enemies.push_back(enemy.state());
+    }
+    out.add(
+      SnapshotSection::Enemies, 0, std::span<EnemyState const>(enemies)
+    );
+    write_pool(out, this->enemies_, behaviour_count);
+  }
+
+  // Restore into fresh stores, then swap them in
+  bool World::read_snapshot(SnapshotView const& in)
+  {
+    auto const* player_state =
+      in.single<PlayerState>(SnapshotSection::Player, 0);
+    // An out of range mode would index past the fire modes
+    if (player_state == nullptr ||
+        player_state->mode >= Player::NUM_MODES) {
+      return false;
+    }
+
+    bool ok = true;
+    std::array<Partition, behaviour_count> parts;
+    std::vector<GameEvent::FireEvent> events;
+    for_each_behaviour([&]<typename B>() {
+      auto const id = behaviour_id<B>;
+      auto& part = parts[id];
+      part.kin = internal::Kinematics(B::motion);
+      auto const looks =
+        in.section<BulletLook>(SnapshotSection::BulletLooks, id);
+      if (!ok || !looks) {
+        ok = false;
+        return;
+      }
+
+      // Columns are copied whole, straight from the snapshot
+      size_t const count = looks->size();
+      part.kin.extend(count);
+      std::uint32_t column = 0;
+      part.kin.for_each_column([&](auto& values) {
+        using T = std::ranges::range_value_t<decltype(values)>;
+        auto const saved = in.section<T>(
+          SnapshotSection::BulletColumn, column_index(id, column++)
+        );
+        if (!saved || saved->size() != count) {
+          ok = false;
+          return;
+        }
+        std::ranges::copy(*saved, values.begin());
+      });
+
+      // Bullets only need their sprite back
+      events.clear();
+      for (size_t idx = 0; ok && idx < count; idx++) {
+        events.push_back({
+          .position = {part.kin.px[idx], part.kin.py[idx]},
+          .velocity = {part.kin.vx[idx], part.kin.vy[idx]},
+          .sprite = (*looks)[idx].sprite,
+          .size = (*looks)[idx].size,
+          .behaviour_id = id,
+          .lifetime = part.kin.life[idx],
+        });
+      }
+      ok = ok && read_pool(
+                   in,
+                   part.bullets,
+                   id,
+                   std::span<GameEvent::FireEvent const>(events)
+                 );
+    });
+
+    Pool<Enemy> enemies;
+    auto const enemy_states =
+      in.section<EnemyState>(SnapshotSection::Enemies, 0);
+    ok = ok && enemy_states &&
+         read_pool(in, enemies, behaviour_count, *enemy_states, this->bus);
+    if (!ok) {
+      return false;
+    }
+
+    this->player.restore(*player_state);
+    this->partitions_ = std::move(parts);
+    this->enemies_ = std::move(enemies);
+    this->animation_ = {};
+    for (auto& enemy : this->enemies_) {
+      enemy.join(this->animation_);
+    }
+    this->enemy_colliders_.clear();
+    this->bursts_.clear();
+    this->particles_.clear();
+    return true;
+  }
 }  //namespace kalika
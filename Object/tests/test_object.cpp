@@ -1,3 +1,1559 @@
-int main() {
-return 0;
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Event/GameEvent.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <Object/Animation.hpp>
+#include <Object/Behaviour.hpp>
+#include <Object/Collision.hpp>
+#include <Object/InputLog.hpp>
+#include <Object/Kinematics.hpp>
+#include <Object/Particles.hpp>
+#include <Object/Player.hpp>
+#include <Object/Pool.hpp>
+#include <Object/Rewind.hpp>
+#include <Object/Snapshot.hpp>
+#include <Object/Targeting.hpp>
+#include <Object/Wave.hpp>
+#include <Profile/LogChannel.hpp>
+#include <Profile/Profiler.hpp>
+#include <Simulation.hpp>
+
+namespace
+{
+  // Minimal poolable object
+  struct Dummy {
+    int value;
+
+    Dummy(int v) : value(v) {}
+
+    void rebuild(int v) { this->value = v; }
+  };
+
+  // Fail the test with a message
+  bool check(bool cond, char const* msg)
+  {
+    if (!cond) {
+      std::cerr << "FAILED: " << msg << '\n';
+    }
+    return cond;
+  }
+
+  bool pool_acquire()
+  {
+    Pool<Dummy> pool;
+    auto const a = pool.acquire(1);
+    auto const b = pool.acquire(2);
+
+    return check(pool.size() == 2, "size after acquire") &&
+           check(pool.get(a)->value == 1, "lookup a") &&
+           check(pool.get(b)->value == 2, "lookup b") &&
+           check(!(a == b), "distinct handles");
+  }
+
+  bool pool_release()
+  {
+    Pool<Dummy> pool;
+    auto const a = pool.acquire(1);
+    auto const b = pool.acquire(2);
+    auto const c = pool.acquire(3);
+
+    // Swap-remove keeps the live range packed
+    bool ok = check(pool.release(a), "release a") &&
+              check(pool.size() == 2, "size after release") &&
+              check(pool.get(b)->value == 2, "b survives swap") &&
+              check(pool.get(c)->value == 3, "c survives swap");
+
+    int sum = 0;
+    for (auto const& obj : pool) {
+      sum += obj.value;
+    }
+    ok = ok && check(sum == 5, "iterate live objects");
+
+    // Released objects are rebuilt instead of reallocated
+    pool.acquire(4);
+    return ok && check(pool.capacity() == 3, "slot recycled");
+  }
+
+  bool pool_stale_handle()
+  {
+    Pool<Dummy> pool;
+    auto const a = pool.acquire(1);
+    pool.release(a);
+    auto const b = pool.acquire(2);
+
+    return check(a.idx == b.idx, "sparse slot reused") &&
+           check(!pool.valid(a), "stale handle invalid") &&
+           check(pool.get(a) == nullptr, "stale lookup") &&
+           check(!pool.release(a), "stale release rejected") &&
+           check(pool.get(b)->value == 2, "live object untouched");
+  }
+
+  bool pool_acquire_bulk()
+  {
+    Pool<Dummy> pool;
+    auto const a = pool.acquire(1);
+    pool.acquire(2);
+    pool.release(a);
+
+    // One recycled object and two new ones
+    std::array<int, 3> const values = {10, 20, 30};
+    auto const first = pool.acquire_bulk(std::span<int const>(values));
+
+    bool ok = check(first == 1, "batch starts after live objects") &&
+              check(pool.size() == 4, "size after bulk") &&
+              check(pool.capacity() == 4, "one slot recycled");
+    for (size_t i = 0; i < values.size(); i++) {
+      auto const handle = pool.handle(first + i);
+      ok = ok &&
+           check(pool.get(handle)->value == values[i], "bulk lookup");
+    }
+    return ok && check(!pool.valid(a), "released handle stays stale");
+  }
+
+  bool pool_prewarm()
+  {
+    Pool<Dummy> pool;
+    pool.prewarm(8, 0);
+    bool ok = check(pool.size() == 0, "prewarmed objects are dead") &&
+              check(pool.capacity() == 8, "objects built up front");
+
+    // Spawning up to the prewarmed size only rebuilds
+    std::array<int, 6> const values = {1, 2, 3, 4, 5, 6};
+    auto const* const storage = &pool[0];
+    pool.acquire_bulk(std::span<int const>(values));
+    auto const c = pool.acquire(7);
+    auto const d = pool.acquire(8);
+    return ok && check(pool.size() == 8, "size") &&
+           check(pool.capacity() == 8, "no growth") &&
+           check(&pool[0] == storage, "no reallocation") &&
+           check(pool.get(c)->value == 7, "rebuilt") &&
+           check(pool.get(d)->value == 8, "rebuilt last");
+  }
+
+  // Fill a store with a mix of straight and homing objects
+  kalika::internal::Kinematics random_store(size_t count)
+  {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::uniform_real_distribution<float> vel(-800.F, 800.F);
+    std::uniform_real_distribution<float> life(0.F, 2.F);
+
+    kalika::internal::Kinematics kin;
+    for (size_t i = 0; i < count; i++) {
+      kin.push(
+        pos(gen), pos(gen), vel(gen), vel(gen), life(gen), (i % 3) * 250.F
+      );
+      kin.tx[i] = pos(gen);
+      kin.ty[i] = pos(gen);
+    }
+    return kin;
+  }
+
+  // Compare two columns with a relative tolerance
+  bool close(std::vector<float> const& a, std::vector<float> const& b)
+  {
+    for (size_t i = 0; i < a.size(); i++) {
+      float const scale = std::fmax(1.F, std::fabs(a[i]));
+      if (std::fabs(a[i] - b[i]) > 1e-4F * scale) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool kinematics_simd()
+  {
+    using kalika::internal::Motion;
+    using kalika::internal::SimdLevel;
+    kalika::internal::StepParams const params{
+      .dt = 1.F / 60.F, .left = 80.F, .top = 50.F, .width = 1520.F,
+      .height = 950.F
+    };
+
+    bool ok = true;
+    for (auto motion : {Motion::Straight, Motion::Homing}) {
+      // Run a few steps with the scalar reference
+      auto expected = random_store(1003);
+      for (int step = 0; step < 8; step++) {
+        kalika::internal::integrate(
+          expected, params, motion, SimdLevel::Scalar
+        );
+      }
+
+      // Every level the CPU supports must match it
+      for (auto level :
+           {SimdLevel::Sse, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > kalika::internal::detect_simd()) {
+          continue;
+        }
+        auto kin = random_store(1003);
+        for (int step = 0; step < 8; step++) {
+          kalika::internal::integrate(kin, params, motion, level);
+        }
+
+        bool const match = close(kin.px, expected.px) &&
+                           close(kin.py, expected.py) &&
+                           close(kin.vx, expected.vx) &&
+                           close(kin.vy, expected.vy) &&
+                           close(kin.dx, expected.dx) &&
+                           close(kin.dy, expected.dy) &&
+                           close(kin.life, expected.life);
+        ok = check(match, kalika::internal::simd_name(level)) && ok;
+        for (size_t i = 0; i < kin.size(); i++) {
+          ok = ok && check(
+                       kin.is_alive(i) == expected.is_alive(i),
+                       "alive mask"
+                     );
+        }
+      }
+    }
+    return ok;
+  }
+
+  bool homing_agrees()
+  {
+    using kalika::internal::Motion;
+    using kalika::internal::SimdLevel;
+    constexpr size_t count = 257;
+    constexpr float dt = 1.F / 60.F;
+    kalika::internal::StepParams const params{
+      .dt = dt, .left = -1e9F, .top = -1e9F, .width = 2e9F,
+      .height = 2e9F
+    };
+
+    // Chaser bullets, every one with its own target
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::uniform_real_distribution<float> vel(-800.F, 800.F);
+    kalika::internal::Kinematics start(Motion::Homing);
+    for (size_t i = 0; i < count; i++) {
+      start.push(
+        pos(gen), pos(gen), vel(gen), vel(gen), 1.F,
+        kalika::Chaser::homing_factor
+      );
+      start.tx[i] = pos(gen);
+      start.ty[i] = pos(gen);
+    }
+    // A target right on the bullet must not turn it
+    start.tx[0] = start.px[0];
+    start.ty[0] = start.py[0];
+
+    // The velocity a homing enemy would get from Chaser::accel
+    std::vector<float> evx(count);
+    std::vector<float> evy(count);
+    for (size_t i = 0; i < count; i++) {
+      kalika::internal::Movable self;
+      self.pos = {start.px[i], start.py[i]};
+      self.vel = {start.vx[i], start.vy[i]};
+      self.up = {start.dx[i], start.dy[i]};
+      kalika::internal::Movable target;
+      target.pos = {start.tx[i], start.ty[i]};
+      auto const accel = kalika::Chaser{}.accel(self, target);
+      auto const next = self.vel + (accel * dt);
+      evx[i] = next.x;
+      evy[i] = next.y;
+    }
+
+    // Bullets on every level turn the same way
+    bool ok = true;
+    for (auto level : {SimdLevel::Scalar,
+                       SimdLevel::Sse,
+                       SimdLevel::Avx2,
+                       SimdLevel::Avx512}) {
+      if (level > kalika::internal::detect_simd()) {
+        continue;
+      }
+      auto kin = start;
+      kalika::internal::integrate(kin, params, Motion::Homing, level);
+      kin.vx.resize(count);
+      kin.vy.resize(count);
+      bool const match = close(kin.vx, evx) && close(kin.vy, evy);
+      ok = check(match, kalika::internal::simd_name(level)) && ok;
+    }
+    return ok;
+  }
+
+  bool kinematics_swap_remove()
+  {
+    kalika::internal::Kinematics kin;
+    kin.push(1.F, 1.F, 0.F, 1.F, 1.F, 0.F);
+    kin.push(2.F, 2.F, 0.F, 1.F, 1.F, 0.F);
+    kin.push(3.F, 3.F, 0.F, 1.F, 1.F, 0.F);
+    kin.swap_remove(0);
+
+    // A burst grows the columns for good; the view covers live lanes
+    kalika::internal::Kinematics burst;
+    for (int i = 0; i < 100; i++) {
+      burst.push(1.F, 1.F, 0.F, 1.F, 1.F, 0.F);
+    }
+    while (burst.size() > 3) {
+      burst.swap_remove(0);
+    }
+
+    return check(kin.size() == 2, "size after remove") &&
+           check(burst.view().count == burst.lanes, "live lanes only") &&
+           check(kin.px[0] == 3.F, "last moved into hole") &&
+           check(kin.px[1] == 2.F, "others untouched") &&
+           check(kin.px.size() % kin.lanes == 0, "columns padded");
+  }
+
+  bool kinematics_straight()
+  {
+    using kalika::internal::Kinematics;
+    using kalika::internal::Motion;
+    kalika::internal::StepParams const params{
+      .dt = 0.5F, .left = 0.F, .top = 0.F, .width = 100.F,
+      .height = 100.F
+    };
+
+    // Straight stores never allocate the steering columns
+    Kinematics kin(Motion::Straight);
+    kin.push(1.F, 1.F, 2.F, 0.F, 1.F, 0.F);
+    kin.push(2.F, 2.F, 2.F, 0.F, 1.F, 0.F);
+    kin.swap_remove(0);
+    // A homing step on a straight store moves straight
+    kalika::internal::integrate(kin, params, Motion::Homing);
+
+    Kinematics homing;
+    homing.push(1.F, 1.F, 2.F, 0.F, 1.F, 0.F);
+    auto const straight_fp = Kinematics::footprint(Motion::Straight);
+    auto const homing_fp = Kinematics::footprint(Motion::Homing);
+
+    return check(!kin.steers() && homing.steers(), "steering flag") &&
+           check(kin.tx.empty() && kin.target.empty(), "no steering") &&
+           check(kin.px[0] == 3.F, "straight step") &&
+           check(straight_fp.hot <= 32, "straight hot bytes") &&
+           check(
+             straight_fp.hot + straight_fp.cold ==
+               (9 * sizeof(float)) + sizeof(std::uint32_t),
+             "every column counted"
+           ) &&
+           check(homing_fp.hot > straight_fp.hot, "homing is hotter") &&
+           check(
+             kin.allocated_bytes() < homing.allocated_bytes(),
+             "straight store is smaller"
+           );
+  }
+
+  bool behaviour_dispatch()
+  {
+    using kalika::behaviour_id;
+    static_assert(behaviour_id<kalika::Dasher> == 0);
+    static_assert(behaviour_id<kalika::Chaser> == 1);
+
+    // Ids resolve to the behaviour's static data
+    bool ok = true;
+    size_t visited = 0;
+    kalika::for_each_behaviour([&]<typename B>() {
+      visited++;
+      auto const id = behaviour_id<B>;
+      auto const frames = kalika::visit_behaviour<size_t>(
+        id, [](auto b) { return decltype(b)::frame_count; }
+      );
+      ok = ok && check(frames == B::frame_count, "visit by id");
+    });
+
+    return ok &&
+           check(visited == kalika::behaviour_count, "visit all") &&
+           check(
+             kalika::homing_factor(behaviour_id<kalika::Chaser>) ==
+               kalika::Chaser::homing_factor,
+             "homing lookup"
+           ) &&
+           check(
+             kalika::homing_factor(kalika::no_behaviour) == 0.F,
+             "unknown id falls back"
+           );
+  }
+
+  bool event_bus_swap()
+  {
+    using kalika::GameEvent;
+    kalika::EventBus bus;
+    bus.emplace(GameEvent::SwitchEvent{1});
+    bus.emplace(GameEvent::SwitchEvent{2});
+    bus.emplace(GameEvent::HitEvent{});
+
+    // Nothing is readable before the swap
+    bool ok =
+      check(bus.events<GameEvent::SwitchEvent>().empty(), "unswapped") &&
+      check(bus.pending() == 3, "pending before swap");
+
+    bus.swap();
+    auto const switches = bus.events<GameEvent::SwitchEvent>();
+    ok = ok && check(switches.size() == 2, "batch size") &&
+         check(switches[1].fire_id == 2, "publish order kept");
+
+    // Events raised while draining wait for the next swap
+    size_t batches = 0;
+    bus.drain([&](auto) {
+      batches++;
+      bus.emplace(GameEvent::SwitchEvent{0});
+    });
+    ok = ok && check(batches == 2, "one batch per non-empty type") &&
+         check(bus.pending() == 2, "raised during drain");
+
+    bus.swap();
+    auto const& stats = bus.stats<GameEvent::SwitchEvent>();
+    return ok && check(stats.count == 2, "last swap count") &&
+           check(stats.high_water == 2, "high water") &&
+           check(stats.total == 4, "total") &&
+           check(
+             bus.stats<GameEvent::HitEvent>().count == 0,
+             "hit channel drained"
+           );
+  }
+
+  bool collision_broadphase()
+  {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> pos(-50.F, 1650.F);
+    std::uniform_real_distribution<float> size(10.F, 60.F);
+
+    // Two partitions of bullets, some of them off the world
+    std::array<std::vector<float>, 2> xs;
+    std::array<std::vector<float>, 2> ys;
+    for (size_t p = 0; p < xs.size(); p++) {
+      for (size_t i = 0; i < 3000; i++) {
+        xs[p].push_back(pos(gen));
+        ys[p].push_back(pos(gen));
+      }
+    }
+    kalika::Colliders enemies;
+    for (std::uint32_t e = 0; e < 80; e++) {
+      enemies.push({pos(gen), pos(gen)}, size(gen), {e, 0});
+    }
+    sf::Vector2f const player = {800.F, 800.F};
+    float const bullet_r = 8.F;
+
+    kalika::Collisions coll;
+    coll.reset({{0.F, 0.F}, {1600.F, 1600.F}}, 64.F, bullet_r);
+    coll.begin(enemies, player, 36.F);
+    for (kalika::BehaviourId p = 0; p < xs.size(); p++) {
+      coll.add_bullets(p, xs[p], ys[p]);
+    }
+
+    // Brute force: every bullet goes to the first enemy it overlaps
+    std::array<std::vector<int>, 2> expected;
+    size_t expected_count = 0;
+    for (size_t p = 0; p < xs.size(); p++) {
+      expected[p].assign(xs[p].size(), -1);
+      for (size_t i = 0; i < xs[p].size(); i++) {
+        for (size_t e = 0; e < enemies.size(); e++) {
+          float const dx = xs[p][i] - enemies.x[e];
+          float const dy = ys[p][i] - enemies.y[e];
+          float const reach = enemies.radius[e] + bullet_r;
+          if ((dx * dx) + (dy * dy) < reach * reach) {
+            expected[p][i] = static_cast<int>(e);
+            expected_count++;
+            break;
+          }
+        }
+      }
+    }
+
+    bool ok = check(expected_count > 0, "scene has overlaps") &&
+              check(
+                coll.contacts().size() == expected_count, "contact count"
+              );
+    for (auto const& contact : coll.contacts()) {
+      ok = ok && check(
+                   expected[contact.behaviour][contact.bullet] ==
+                     static_cast<int>(contact.enemy),
+                   "contact matches brute force"
+                 );
+    }
+
+    size_t rams = 0;
+    for (size_t e = 0; e < enemies.size(); e++) {
+      float const reach = enemies.radius[e] + 36.F;
+      float const dx = enemies.x[e] - player.x;
+      float const dy = enemies.y[e] - player.y;
+      rams += ((dx * dx) + (dy * dy) < reach * reach) ? 1 : 0;
+    }
+    return ok &&
+           check(coll.player_hits().size() == rams, "player hits") &&
+           check(
+             coll.candidates() * 10 < 6000 * enemies.size(),
+             "broadphase culls most pairs"
+           );
+  }
+
+  bool targeting_nearest()
+  {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    sf::FloatRect const world = {{0.F, 0.F}, {1600.F, 1600.F}};
+
+    kalika::Colliders enemies;
+    for (std::uint32_t e = 0; e < 40; e++) {
+      enemies.push({pos(gen), pos(gen)}, 45.F, {e, 0});
+    }
+    kalika::Collisions coll;
+    coll.reset(world, 64.F, 8.F);
+    coll.begin(enemies, {-1000.F, -1000.F}, 1.F);
+
+    // Closest enemy within range by brute force, or npos
+    auto const brute = [&](float x, float y, float range) {
+      slot_id best = npos;
+      float best_sq = range * range;
+      for (slot_id e = 0; e < enemies.size(); e++) {
+        float const dx = enemies.x[e] - x;
+        float const dy = enemies.y[e] - y;
+        float const dist_sq = (dx * dx) + (dy * dy);
+        if (dist_sq < best_sq || (best == npos && dist_sq <= best_sq)) {
+          best = e;
+          best_sq = dist_sq;
+        }
+      }
+      return best;
+    };
+
+    bool ok = true;
+    for (auto i = 0; i < 500; i++) {
+      float const x = pos(gen);
+      float const y = pos(gen);
+      auto const* entry = coll.grid().nearest(x, y, 300.F);
+      slot_id const found = (entry == nullptr) ? npos : entry->id;
+      ok = ok && check(found == brute(x, y, 300.F), "nearest matches");
+    }
+
+    // Every bullet has an enemy in range once all of them searched
+    kalika::internal::Kinematics kin;
+    for (auto i = 0; i < 64; i++) {
+      kin.push(pos(gen), pos(gen), 0.F, 100.F, 5.F, 500.F);
+    }
+    float const range = 2400.F;
+    size_t found = 0;
+    for (size_t tick = 0; tick < kalika::retarget_interval; tick++) {
+      found +=
+        kalika::assign_targets(kin, coll.grid(), enemies, range, tick)
+          .found;
+    }
+    ok = ok && check(found == kin.size(), "every bullet locked on");
+    for (size_t i = 0; i < kin.size(); i++) {
+      slot_id const slot = enemies.find(kin.target[i]);
+      slot_id const nearest = brute(kin.px[i], kin.py[i], range);
+      ok = ok && check(slot == nearest, "locked on the nearest") &&
+           check(kin.tx[i] == enemies.x[slot], "target position");
+    }
+
+    // Targets are cached across ticks
+    auto const cached =
+      kalika::assign_targets(kin, coll.grid(), enemies, range, 0);
+    ok = ok && check(cached.kept == kin.size(), "targets kept") &&
+         check(cached.searched == 0, "no search while locked");
+
+    // Losing a target forces a search, whatever the tick
+    auto const lost = kin.target[0];
+    kalika::Colliders rest;
+    for (slot_id e = 0; e < enemies.size(); e++) {
+      if (enemies.owner[e] != lost) {
+        rest.push({enemies.x[e], enemies.y[e]}, 45.F, enemies.owner[e]);
+      }
+    }
+    coll.begin(rest, {-1000.F, -1000.F}, 1.F);
+    auto const after =
+      kalika::assign_targets(kin, coll.grid(), rest, range, 1);
+    return ok && check(after.searched > 0, "lost targets search") &&
+           check(kin.target[0] != lost, "retargeted") &&
+           check(after.kept + after.found == kin.size(), "all locked");
+  }
+
+  bool jobs_parallel_for()
+  {
+    kalika::JobSystem jobs(4);
+    size_t const count = 100'003;
+    size_t const chunk = 1024;
+    std::vector<std::atomic<int>> hits(count);
+    std::vector<std::atomic<int>> chunks(
+      kalika::JobSystem::chunk_count(count, chunk)
+    );
+
+    // Several batches in a row reuse the sleeping workers
+    for (auto round = 0; round < 8; round++) {
+      jobs.parallel_for(count, chunk, [&](size_t index, auto b, auto e) {
+        chunks[index]++;
+        for (auto i = b; i < e; i++) {
+          hits[i]++;
+        }
+      });
+    }
+
+    bool ok = check(jobs.thread_count() == 4, "thread count");
+    for (auto const& hit : hits) {
+      ok = ok && check(hit == 8, "every index once per batch");
+    }
+    for (auto const& hit : chunks) {
+      ok = ok && check(hit == 8, "every chunk once per batch");
+    }
+
+    // Empty ranges never call back
+    bool called = false;
+    jobs.parallel_for(0, chunk, [&](auto, auto, auto) { called = true; });
+    return ok && check(!called, "empty range");
+  }
+
+  bool jobs_deterministic()
+  {
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<float> pos(0.F, 1600.F);
+    std::vector<float> xs;
+    std::vector<float> ys;
+    for (auto i = 0; i < 20'000; i++) {
+      xs.push_back(pos(gen));
+      ys.push_back(pos(gen));
+    }
+    kalika::Colliders enemies;
+    for (std::uint32_t e = 0; e < 120; e++) {
+      enemies.push({pos(gen), pos(gen)}, 30.F, {e, 0});
+    }
+
+    // Contacts of a serial pass and of threaded passes
+    auto const run = [&](kalika::JobSystem* jobs) {
+      kalika::Collisions coll;
+      coll.reset({{0.F, 0.F}, {1600.F, 1600.F}}, 64.F, 8.F);
+      coll.begin(enemies, {-1000.F, -1000.F}, 1.F);
+      if (jobs == nullptr) {
+        coll.add_bullets(0, xs, ys);
+      }
+      else {
+        coll.add_bullets(0, xs, ys, *jobs, 1024);
+      }
+      auto const contacts = coll.contacts();
+      return std::vector<kalika::Contact>(
+        contacts.begin(), contacts.end()
+      );
+    };
+    auto const same = [](auto const& lhs, auto const& rhs) {
+      auto const eq = [](auto const& a, auto const& b) {
+        return a.behaviour == b.behaviour && a.bullet == b.bullet &&
+               a.enemy == b.enemy;
+      };
+      return std::ranges::equal(lhs, rhs, eq);
+    };
+
+    auto const serial = run(nullptr);
+    bool ok = check(!serial.empty(), "scene has overlaps");
+    for (size_t threads : {1UL, 2UL, 4UL, 7UL}) {
+      kalika::JobSystem jobs(threads);
+      ok = ok && check(same(serial, run(&jobs)), "same contacts");
+    }
+    return ok;
+  }
+
+  bool wave_parse()
+  {
+    auto const wave = kalika::parse_wave(
+      "# time behaviour count every x y dx dy vx vy health life\n"
+      "2   chaser 2 1   0.5 0.5 0   0 0 0 4  3  # trailing comment\n"
+      "\n"
+      "0.5 dasher 3 0.5 0.1 0.2 0.1 0 0 9 5 -1\n"
+    );
+    if (!check(wave.has_value(), "wave parses")) {
+      return false;
+    }
+
+    auto const& spawns = wave->spawns;
+    bool ok = check(spawns.size() == 5, "groups expanded");
+    for (size_t i = 1; ok && i < spawns.size(); i++) {
+      ok = check(spawns[i - 1].time <= spawns[i].time, "sorted");
+    }
+    auto const dasher = kalika::behaviour_id<kalika::Dasher>;
+    ok = ok && check(spawns[0].behaviour == dasher, "behaviour by name") &&
+         check(std::abs(spawns[2].x - 0.3F) < 1e-6F, "position step") &&
+         check(spawns[2].time == 1.5F, "time step") &&
+         check(spawns[4].lifetime == 3.F, "lifetime") &&
+         check(wave->duration == 3.F, "duration is the last spawn") &&
+         // The three dashers stay, and both chasers overlap them
+         check(wave->peak == 5, "peak concurrency");
+
+    // Chasers that expire before the next spawn do not add up
+    auto const staggered = kalika::parse_wave(
+      "0 chaser 4 2 0 0 0 0 0 0 1 1\nend 10\n"
+    );
+    ok = ok && check(staggered.has_value(), "staggered parses") &&
+         check(staggered->peak == 1, "expired enemies leave") &&
+         check(staggered->duration == 10.F, "explicit end");
+
+    // Errors point at the bad line
+    size_t line = 0;
+    auto const bad = kalika::parse_wave(
+      "0 dasher 1 0 0 0 0 0 0 0 1 -1\n0 dancer 1 0 0 0 0 0 0 0 1 -1\n",
+      &line
+    );
+    auto const short_line = kalika::parse_wave("0 dasher 1 0\n");
+    return ok && check(!bad.has_value(), "unknown behaviour") &&
+           check(line == 2, "error line") &&
+           check(!short_line.has_value(), "missing fields");
+  }
+
+  bool wave_scheduler()
+  {
+    using kalika::GameEvent;
+    auto wave = kalika::parse_wave(
+      "0.5 chaser 200 0 0 0.5 0.005 0 0 0 1 -1\n"
+      "1   dasher 2   0 1 1   0     0 5 0 1 -1\n"
+      "end 2\n"
+    );
+    if (!check(wave.has_value(), "wave parses")) {
+      return false;
+    }
+    kalika::WaveScheduler waves(std::move(*wave));
+    kalika::EventBus bus;
+    sf::FloatRect const bounds = {{100.F, 50.F}, {1000.F, 500.F}};
+
+    // Ticks of 0.25 s: nothing, the swarm in one batch, then the dashers
+    std::array<size_t, 4> counts{};
+    for (auto& count : counts) {
+      count = waves.advance(0.25F, bounds, bus);
+    }
+    bus.swap();
+    auto const spawns = bus.events<GameEvent::SpawnEvent>();
+    auto const& first = spawns.front();
+    auto const& last = spawns.back();
+    std::array<size_t, 4> const due = {0, 200, 0, 2};
+    bool ok = check(counts == due, "spawns due per tick") &&
+              check(spawns.size() == 202, "published") &&
+              check(
+                first.position == sf::Vector2f(100.F, 300.F),
+                "position in bounds"
+              ) &&
+              check(
+                last.position == sf::Vector2f(1100.F, 550.F), "far corner"
+              ) &&
+              check(
+                last.sprite == kalika::SpriteId::Dasher,
+                "sprite from behaviour"
+              ) &&
+              check(last.velocity.x == 5.F, "velocity");
+
+    // The wave loops once its duration is up
+    size_t next = 0;
+    for (auto i = 0; i < 6; i++) {
+      next += waves.advance(0.25F, bounds, bus);
+    }
+    return ok && check(waves.pass() == 2, "second pass") &&
+           check(next == 200, "swarm again");
+  }
+
+  bool input_log()
+  {
+    using kalika::GameEvent;
+    kalika::InputLog log;
+    log.dt = 1.F / 120.F;
+    log.dimensions = {1600, 1000};
+    log.ticks = 9;
+    GameEvent::MoveEvent const move{
+      .l_strength = {0.1F, -40.F}, .r_strength = {1e-7F, 100.F}
+    };
+    log.record(2, move);
+    log.record(2, GameEvent::SwitchEvent{2});
+    // Unchanged sticks are not recorded again
+    log.record(5, move);
+    log.record(7, GameEvent::SwitchEvent{0});
+
+    std::stringstream stream;
+    auto const written = log.write(stream);
+    auto const read = kalika::InputLog::read(stream);
+    bool ok = check(written && read.has_value(), "log round trip") &&
+              check(log.frames.size() == 2, "unchanged sticks dropped") &&
+              check(read->frames.size() == 2, "frames read back") &&
+              check(read->dt == log.dt && read->ticks == 9, "header") &&
+              check(
+                read->frames[0].r_strength == move.r_strength,
+                "floats kept bit for bit"
+              );
+
+    // Each frame is published on its tick
+    kalika::EventBus bus;
+    kalika::InputReplay replay(*read);
+    replay.feed(1, bus);
+    ok = ok && check(bus.pending() == 0, "nothing before tick 2");
+    replay.feed(2, bus);
+    bus.swap();
+    auto const moves = bus.events<GameEvent::MoveEvent>();
+    ok = ok && check(moves.size() == 1, "move replayed") &&
+         check(moves[0].l_strength == move.l_strength, "stick kept") &&
+         check(
+           bus.events<GameEvent::SwitchEvent>()[0].fire_id == 2,
+           "switch replayed"
+         ) &&
+         check(!replay.done(8) && replay.done(9), "end of replay");
+
+    // A switch to a mode the player lacks is rejected
+    kalika::InputLog unknown = log;
+    unknown.frames.back().fire_id = kalika::Player::NUM_MODES;
+    std::stringstream bad_mode;
+    unknown.write(bad_mode);
+
+    // Truncated and foreign streams are rejected
+    std::stringstream cut(stream.str().substr(0, 30));
+    std::stringstream foreign("KWAV....");
+    return ok && check(!kalika::InputLog::read(cut), "truncated") &&
+           check(!kalika::InputLog::read(foreign), "bad magic") &&
+           check(!kalika::InputLog::read(bad_mode), "unknown mode");
+  }
+
+  bool snapshot_format()
+  {
+    using kalika::SnapshotSection;
+    Pool<Dummy> pool;
+    auto const a = pool.acquire(1);
+    auto const b = pool.acquire(2);
+    auto const c = pool.acquire(3);
+    pool.release(a);
+
+    // Save the pool as flat sections
+    std::vector<int> values;
+    for (auto const& obj : pool) {
+      values.push_back(obj.value);
+    }
+    kalika::SnapshotWriter out;
+    out.add(SnapshotSection::Enemies, 0, std::span<int const>(values));
+    out.add(SnapshotSection::PoolOwners, 0, pool.owners());
+    out.add(SnapshotSection::PoolEntries, 0, pool.entries());
+    out.add(SnapshotSection::PoolFreeHead, 0, pool.free_head());
+    auto bytes = out.bytes();
+
+    auto const view = kalika::SnapshotView::from_bytes(bytes);
+    bool ok = check(view.has_value(), "snapshot round trip");
+    if (!ok) {
+      return false;
+    }
+    auto const saved =
+      view->section<int>(SnapshotSection::Enemies, 0).value();
+    auto const owners =
+      view->section<slot_id>(SnapshotSection::PoolOwners, 0).value();
+    auto const entries =
+      view->section<Pool<Dummy>::Sparse>(SnapshotSection::PoolEntries, 0)
+        .value();
+    auto const* free_head =
+      view->single<slot_id>(SnapshotSection::PoolFreeHead, 0);
+    // Offsets are aligned from the start of the file
+    auto const offset = static_cast<size_t>(
+      std::as_bytes(saved).data() - view->bytes().data()
+    );
+    ok = check(saved.size() == 2, "section size") &&
+         check(offset % kalika::snapshot_align == 0, "sections aligned") &&
+         check(
+           !view->section<float>(SnapshotSection::PoolFreeHead, 0),
+           "element size checked"
+         ) &&
+         check(
+           !view->section<int>(SnapshotSection::Player, 0),
+           "missing section"
+         );
+
+    // Handles saved with the pool stay valid, stale ones stay stale
+    Pool<Dummy> restored;
+    ok = ok && check(
+                 restored.restore(saved, owners, entries, *free_head),
+                 "pool restored"
+               ) &&
+         check(restored.size() == 2, "restored size") &&
+         check(restored.get(b)->value == 2, "handle b kept") &&
+         check(restored.get(c)->value == 3, "handle c kept") &&
+         check(!restored.get(a), "stale handle kept stale") &&
+         check(!(restored.acquire(4) == a), "freed slot reused");
+
+    // Inconsistent bookkeeping leaves the pool alone
+    std::vector<slot_id> bad(owners.begin(), owners.end());
+    bad[0] = 99;
+    Pool<Dummy> untouched;
+    ok = ok && check(
+                 !untouched.restore(saved, bad, entries, *free_head) &&
+                   untouched.size() == 0,
+                 "bad owners rejected"
+               );
+
+    // Corrupt entries: a live one past the objects, one claiming the
+    // slot of another, and a live one on the free list
+    using Entries = std::vector<Pool<Dummy>::Sparse>;
+    auto const corrupt = [&](auto&& edit) {
+      Entries copy(entries.begin(), entries.end());
+      slot_id head = *free_head;
+      edit(copy, head);
+      return !untouched.restore(saved, owners, copy, head) &&
+             untouched.size() == 0;
+    };
+    ok = ok &&
+         check(
+           corrupt([&](Entries& e, slot_id&) { e[a.idx].dense = 7; }),
+           "dense past the end rejected"
+         ) &&
+         check(
+           corrupt([&](Entries& e, slot_id&) {
+             e[a.idx].dense = e[b.idx].dense;
+           }),
+           "shared dense slot rejected"
+         ) &&
+         check(
+           corrupt([&](Entries& e, slot_id& head) {
+             e[b.idx].next_free = head;
+             head = b.idx;
+           }),
+           "live entry on the free list rejected"
+         );
+
+    // Padding never reaches the file, whatever the memory held
+    struct Padded {
+      std::uint8_t tag;
+      float value;
+    };
+    std::array<std::byte, sizeof(Padded)> dirty{};
+    dirty.fill(std::byte{0xAB});
+    Padded item{};
+    std::memcpy(&item, dirty.data(), sizeof(item));
+    item.tag = 1;
+    item.value = 2.F;
+    kalika::SnapshotWriter padded;
+    padded.add(SnapshotSection::Player, 0, item);
+    auto const clean = kalika::SnapshotView::from_bytes(padded.bytes());
+    auto const raw = std::as_bytes(
+      clean->section<Padded>(SnapshotSection::Player, 0).value()
+    );
+    ok = check(
+           std::all_of(
+             raw.begin() + 1,
+             raw.begin() + offsetof(Padded, value),
+             [](std::byte byte) { return byte == std::byte{0}; }
+           ),
+           "padding zeroed"
+         ) &&
+         ok;
+
+    // Truncated and foreign files are rejected
+    auto cut = bytes;
+    cut.resize(cut.size() - 1);
+    auto foreign = bytes;
+    foreign[0] = std::byte{'X'};
+    return ok &&
+           check(!kalika::SnapshotView::from_bytes(cut), "truncated") &&
+           check(!kalika::SnapshotView::from_bytes(foreign), "bad magic");
+  }
+
+  bool fire_timers()
+  {
+    using kalika::FireTimers;
+    using kalika::FireType;
+    auto const timers = [](FireType const& mode) {
+      return std::visit([](auto const& m) { return m.timers(); }, mode);
+    };
+    auto const restore = [](FireType& mode, FireTimers const& saved) {
+      std::visit([&](auto& m) { m.restore(saved); }, mode);
+    };
+
+    // Every mode hands back the timers it was given, the chaser's side
+    // included
+    bool ok = true;
+    for (FireType mode : {FireType(kalika::RapidFire()),
+                          FireType(kalika::SpreadFire()),
+                          FireType(kalika::ChaserFire())}) {
+      FireTimers const saved{
+        .elapsed = 0.25F, .spawn = 0, .toggle = 0, .reserved = {}
+      };
+      restore(mode, saved);
+      auto const back = timers(mode);
+      ok = check(back.elapsed == 0.25F && back.spawn == 0, "timers") &&
+           check(back.toggle == 0, "side") && ok;
+    }
+
+    // Any non-zero flag byte reads as set
+    FireType chaser = kalika::ChaserFire();
+    restore(
+      chaser, {.elapsed = 0.F, .spawn = 7, .toggle = 9, .reserved = {}}
+    );
+    auto const back = timers(chaser);
+    return check(back.spawn == 1 && back.toggle == 1, "flags") && ok;
+  }
+
+  bool rewind_buffer()
+  {
+    using kalika::SnapshotSection;
+    // A column where one slot moves per tick and that grows every
+    // fourth tick, plus a single counter
+    std::vector<float> column(1000, 1.F);
+    std::vector<std::vector<std::byte>> states;
+    kalika::RewindBuffer history(1UL << 20U, 8);
+    bool ok = true;
+    for (std::uint64_t tick = 1; tick <= 20; tick++) {
+      column[(tick * 37) % column.size()] += 1.F;
+      if (tick % 4 == 0) {
+        column.push_back(static_cast<float>(tick));
+      }
+      kalika::SnapshotWriter out;
+      out.add(SnapshotSection::Simulation, 0, tick);
+      out.add(
+        SnapshotSection::BulletColumn, 0, std::span<float const>(column)
+      );
+      states.push_back(out.bytes());
+      auto state = states.back();
+      ok = ok && check(history.capture(tick, state), "tick captured");
+    }
+
+    // Every tick comes back bit for bit
+    ok = ok && check(history.size() == 20, "every tick held") &&
+              check(
+                history.bytes() < 4 * states.back().size(),
+                "deltas are small"
+              );
+    for (std::uint64_t tick = 1; tick <= 20; tick++) {
+      auto const state = history.at(tick);
+      ok = ok && check(state.has_value(), "tick rebuilt") &&
+           check(
+             std::ranges::equal(state->bytes(), states[tick - 1]),
+             "rebuilt state matches"
+           );
+    }
+    std::vector<std::byte> junk(64);
+    ok = ok && check(!history.at(21), "future tick") &&
+         check(!history.at(0), "past tick") &&
+         check(!history.capture(21, junk), "junk rejected");
+
+    // Branching off forgets the later ticks
+    history.truncate(12);
+    ok = ok && check(history.newest() == 12, "truncated") &&
+         check(
+           std::ranges::equal(history.at(12)->bytes(), states[11]),
+           "truncated state kept"
+         );
+
+    // Over budget, whole keyframe intervals are dropped, oldest first
+    kalika::RewindBuffer small(3 * states.back().size(), 4);
+    for (std::uint64_t tick = 1; tick <= 20; tick++) {
+      auto state = states[tick - 1];
+      small.capture(tick, state);
+    }
+    return ok && check(small.bytes() <= small.budget(), "within budget") &&
+           check(small.newest() == 20, "newest kept") &&
+           check(
+             (small.oldest() - 1) % 4 == 0, "whole intervals dropped"
+           ) &&
+           check(
+             std::ranges::equal(
+               small.at(small.oldest() + 2)->bytes(),
+               states[small.oldest() + 1]
+             ),
+             "oldest interval intact"
+           );
+  }
+
+  bool animation_clock()
+  {
+    kalika::AnimationClock clock;
+    auto const fast = clock.group(3, 4);
+    auto const slow = clock.group(5, 2);
+    bool ok = check(clock.group(3, 4) == fast, "cadences share a group") &&
+              check(fast != slow, "distinct cadences") &&
+              check(clock.group_count() == 2, "group count");
+
+    // Record which ticks changed anything, over a full cycle of both
+    std::vector<unsigned> fast_frames;
+    size_t idle = 0;
+    for (auto tick = 1; tick <= 60; tick++) {
+      clock.step();
+      ok = ok && check(
+                   clock.changed(fast) == (tick % 3 == 0), "fast cadence"
+                 ) &&
+           check(clock.changed(slow) == (tick % 5 == 0), "slow cadence");
+      if (clock.changed(fast)) {
+        fast_frames.push_back(clock.frame(fast));
+      }
+      idle += clock.any_changed() ? 0 : 1;
+    }
+    std::vector<unsigned> const expected = {
+      1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0
+    };
+
+    // Single frame strips never report a change
+    kalika::AnimationClock still;
+    auto const single = still.group(1, 1);
+    still.step();
+    return ok && check(fast_frames == expected, "frames wrap") &&
+           check(idle == 32, "ticks without any change") &&
+           check(clock.frame(slow) == 0, "slow back to start") &&
+           check(!still.changed(single), "single frame") &&
+           check(!still.any_changed(), "nothing to do");
+  }
+  bool particles_step()
+  {
+    using kalika::internal::SimdLevel;
+    constexpr size_t count = 1008;
+    kalika::internal::ParticleParams const params{
+      .dt = 1.F / 60.F, .damp = 0.95F
+    };
+
+    // Columns of random particles, some about to expire
+    auto const columns = [] {
+      std::mt19937 gen(11);
+      std::uniform_real_distribution<float> pos(0.F, 1000.F);
+      std::uniform_real_distribution<float> vel(-300.F, 300.F);
+      std::uniform_real_distribution<float> life(0.F, 0.2F);
+      std::array<std::vector<float>, 7> cols;
+      for (auto& col : cols) {
+        col.resize(count);
+      }
+      for (size_t i = 0; i < count; i++) {
+        cols[0][i] = pos(gen);
+        cols[1][i] = pos(gen);
+        cols[2][i] = vel(gen);
+        cols[3][i] = vel(gen);
+        cols[4][i] = life(gen);
+        cols[5][i] = 5.F;
+      }
+      return cols;
+    };
+    auto const run = [&](SimdLevel level) {
+      auto cols = columns();
+      kalika::internal::ParticleView const view{
+        .px = cols[0].data(), .py = cols[1].data(), .vx = cols[2].data(),
+        .vy = cols[3].data(), .life = cols[4].data(),
+        .inv_lifetime = cols[5].data(), .fade = cols[6].data(),
+        .count = count
+      };
+      for (int step = 0; step < 8; step++) {
+        kalika::internal::step_particles(view, params, level);
+      }
+      return cols;
+    };
+
+    // Every level the CPU supports must match the scalar reference
+    bool ok = true;
+    auto const expected = run(SimdLevel::Scalar);
+    for (auto level :
+         {SimdLevel::Sse, SimdLevel::Avx2, SimdLevel::Avx512}) {
+      if (level > kalika::internal::detect_simd()) {
+        continue;
+      }
+      auto const cols = run(level);
+      bool match = true;
+      for (size_t col = 0; col < cols.size(); col++) {
+        match = match && close(cols[col], expected[col]);
+      }
+      ok = check(match, kalika::internal::simd_name(level)) && ok;
+    }
+
+    // Bursts past the capacity are cut short, without reallocating
+    kalika::ParticleSystem particles(100);
+    auto const* data = particles.columns(kalika::ParticleKind::Spark)
+                         .x.data();
+    std::vector<kalika::ParticleBurst> const bursts(
+      20,
+      {.position = {50.F, 50.F}, .velocity = {}, .strength = 1.F,
+       .kind = kalika::ParticleKind::Spark}
+    );
+    size_t const spawned = particles.emit(bursts);
+    auto const sparks = particles.columns(kalika::ParticleKind::Spark);
+    bool const apart =
+      particles.size(kalika::ParticleKind::Debris) == 0;
+    ok = check(spawned == 100, "spawned up to capacity") &&
+         check(particles.dropped() == 60, "rest dropped") &&
+         check(sparks.x.data() == data, "no reallocation") &&
+         check(apart, "kinds kept apart") && ok;
+
+    // Fade stays within range while the particles live, and every one
+    // is gone once the longest lifetime has passed
+    particles.update(0.1F);
+    auto const live = particles.columns(kalika::ParticleKind::Spark);
+    bool const faded = std::ranges::all_of(live.fade, [](float fade) {
+      return fade > 0.F && fade < 1.F;
+    });
+    ok = check(faded, "fade in range") && ok;
+    particles.update(kalika::style(kalika::ParticleKind::Spark).max_life);
+    return check(particles.size() == 0, "dead particles compacted") &&
+           ok;
+  }
+  // Frame time of whole milliseconds, as end_frame takes it
+  float frames_ms(int ms) { return static_cast<float>(ms) * 1e-3F; }
+
+  /**
+   * @brief Strict enough JSON reader to tell a well-formed trace from a
+   * broken one. Reads values without keeping them.
+   */
+  struct JsonReader {
+    std::string_view text;
+    size_t pos = 0;
+
+    bool value()
+    {
+      this->skip();
+      if (this->pos >= this->text.size()) {
+        return false;
+      }
+      switch (this->text[this->pos]) {
+        case '{':
+          return this->object();
+        case '[':
+          return this->array();
+        case '"':
+          return this->string();
+        case 't':
+          return this->literal("true");
+        case 'f':
+          return this->literal("false");
+        case 'n':
+          return this->literal("null");
+        default:
+          return this->number();
+      }
+    }
+
+    // Nothing but whitespace left
+    bool done()
+    {
+      this->skip();
+      return this->pos == this->text.size();
+    }
+
+  private:
+    void skip()
+    {
+      for (; this->pos < this->text.size(); this->pos++) {
+        auto const ch = static_cast<unsigned char>(this->text[this->pos]);
+        if (std::isspace(ch) == 0) {
+          return;
+        }
+      }
+    }
+
+    bool eat(char ch)
+    {
+      this->skip();
+      if (this->pos < this->text.size() && this->text[this->pos] == ch) {
+        this->pos++;
+        return true;
+      }
+      return false;
+    }
+
+    bool literal(std::string_view word)
+    {
+      if (!this->text.substr(this->pos).starts_with(word)) {
+        return false;
+      }
+      this->pos += word.size();
+      return true;
+    }
+
+    bool string()
+    {
+      this->pos++;
+      while (this->pos < this->text.size()) {
+        char const ch = this->text[this->pos++];
+        if (ch == '"') {
+          return true;
+        }
+        if (ch == '\\') {
+          this->pos++;
+        }
+        else if (static_cast<unsigned char>(ch) < 0x20) {
+          return false;
+        }
+      }
+      return false;
+    }
+
+    bool number()
+    {
+      auto const start = this->pos;
+      this->eat('-');
+      constexpr std::string_view numeric = "0123456789.eE+-";
+      while (this->pos < this->text.size() &&
+             numeric.find(this->text[this->pos]) != numeric.npos) {
+        this->pos++;
+      }
+      auto const digits = this->text.substr(start, this->pos - start);
+      return !digits.empty() &&
+             std::isdigit(static_cast<unsigned char>(digits.back()));
+    }
+
+    bool array()
+    {
+      this->pos++;
+      if (this->eat(']')) {
+        return true;
+      }
+      do {
+        if (!this->value()) {
+          return false;
+        }
+      } while (this->eat(','));
+      return this->eat(']');
+    }
+
+    bool object()
+    {
+      this->pos++;
+      if (this->eat('}')) {
+        return true;
+      }
+      do {
+        this->skip();
+        if (this->pos >= this->text.size() ||
+            this->text[this->pos] != '"' || !this->string() ||
+            !this->eat(':') || !this->value()) {
+          return false;
+        }
+      } while (this->eat(','));
+      return this->eat('}');
+    }
+  };
+
+  bool log_channel()
+  {
+    using kalika::LogChannel;
+    LogChannel channel;
+
+    // Messages come out in order, cut to a slot, and a full channel
+    // drops new ones
+    bool ok = check(channel.push(std::string(200, 'x')), "push");
+    for (size_t i = 1; i < LogChannel::capacity; i++) {
+      channel.print("message {}", i);
+    }
+    bool const full = !channel.push("one too many");
+    std::vector<std::string> got;
+    channel.drain([&](std::string_view text) { got.emplace_back(text); });
+    ok = check(full && channel.dropped() == 1, "full channel drops") &&
+         check(got.size() == LogChannel::capacity, "every message") &&
+         check(got[0].size() == LogChannel::message_size, "cut") &&
+         check(got[5] == "message 5", "in order") &&
+         check(channel.push("again"), "room after drain") && ok;
+    channel.drain([](std::string_view) {});
+
+    // Writers on several threads while this one reads: nothing is torn
+    // or reordered within a writer, and every message is either read
+    // or counted as dropped
+    constexpr int writers = 4;
+    constexpr int per_writer = 5000;
+    size_t const dropped = channel.dropped();
+    std::array<int, writers> last{-1, -1, -1, -1};
+    size_t received = 0;
+    bool ordered = true;
+    auto const read = [&](std::string_view text) {
+      std::istringstream in{std::string(text)};
+      int writer = -1;
+      int idx = -1;
+      in >> writer >> idx;
+      bool const valid = writer >= 0 && writer < writers;
+      ordered = ordered && valid && idx > last[writer];
+      if (valid) {
+        last[writer] = idx;
+      }
+      received++;
+    };
+    {
+      std::atomic<int> done = 0;
+      std::vector<std::jthread> threads;
+      for (int writer = 0; writer < writers; writer++) {
+        threads.emplace_back([&, writer] {
+          for (int idx = 0; idx < per_writer; idx++) {
+            channel.print("{} {}", writer, idx);
+          }
+          done++;
+        });
+      }
+      while (done < writers) {
+        channel.drain(read);
+      }
+    }
+    channel.drain(read);
+    size_t const lost = channel.dropped() - dropped;
+    return check(ordered, "per writer order") &&
+           check(received + lost == writers * per_writer, "accounted") &&
+           ok;
+  }
+
+  bool fixed_step()
+  {
+    kalika::FixedStep timestep(60.F, 4);
+    float const step = timestep.step;
+    auto const near = [&](float a, float b) {
+      return std::fabs(a - b) < 1e-5F;
+    };
+
+    // Whole ticks are paid out and the remainder is kept
+    bool ok = check(timestep.advance(2.5F * step) == 2, "two ticks") &&
+              check(near(timestep.accumulator, 0.5F * step), "remainder");
+    ok = check(timestep.advance(0.75F * step) == 1, "carried over") &&
+         check(near(timestep.accumulator, 0.25F * step), "kept") && ok;
+    ok = check(timestep.advance(0.F) == 0, "nothing banked") && ok;
+
+    // A hitch is cut to the cap and only the part tick survives
+    ok = check(timestep.advance(10.F * step) == 4, "capped") &&
+         check(near(timestep.accumulator, 0.25F * step), "fmod") && ok;
+
+    // The interpolation factor stays in [0, 1) whatever the frame
+    // times, hitches included
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> frame(0.F, 3.F * step);
+    bool bounded = true;
+    for (int i = 0; i < 10000; i++) {
+      float const dt = (i % 97 == 0) ? 20.F * step : frame(gen);
+      timestep.advance(dt);
+      bounded = bounded && timestep.alpha() >= 0.F &&
+                timestep.alpha() < 1.F;
+    }
+    return check(bounded, "alpha in [0, 1)") && ok;
+  }
+  bool frame_stats()
+  {
+    kalika::Profiler prof;
+    bool ok = check(prof.frame_stats().max == 0.F, "empty window");
+
+    // Frames of 1 to 100 ms, in a scrambled order
+    std::vector<float> frames;
+    for (int ms = 1; ms <= 100; ms++) {
+      frames.push_back(static_cast<float>(ms) * 1e-3F);
+    }
+    std::shuffle(frames.begin(), frames.end(), std::mt19937(3));
+    for (float const frame : frames) {
+      prof.end_frame(frame);
+    }
+    auto stats = prof.frame_stats();
+    ok = check(stats.p50 == frames_ms(50), "p50") &&
+         check(stats.p95 == frames_ms(95), "p95") &&
+         check(stats.p99 == frames_ms(99), "p99") &&
+         check(stats.max == frames_ms(100), "max") && ok;
+
+    // Only the last window of frames counts
+    for (size_t i = 0; i < kalika::Profiler::frame_window; i++) {
+      prof.end_frame(frames_ms(5));
+    }
+    stats = prof.frame_stats();
+    return check(stats.p50 == frames_ms(5), "window p50") &&
+           check(stats.max == frames_ms(5), "window max") && ok;
+  }
+
+  bool span_ring()
+  {
+    using kalika::SpanRing;
+    auto ring = std::make_unique<SpanRing>(0);
+    auto const push = [&](std::uint64_t from, std::uint64_t to) {
+      for (auto idx = from; idx < to; idx++) {
+        ring->push({"span", idx, idx + 1});
+      }
+    };
+    // Spans come out oldest first and in order
+    auto const ordered = [](std::vector<kalika::Span> const& spans) {
+      for (size_t i = 1; i < spans.size(); i++) {
+        if (spans[i].begin != spans[i - 1].begin + 1) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    push(0, 10);
+    auto spans = ring->snapshot();
+    bool ok = check(spans.size() == 10, "partial ring") &&
+              check(spans.front().begin == 0, "partial oldest") &&
+              check(ordered(spans), "partial order");
+
+    // Once the writer laps the ring only the newest capacity survive
+    push(10, SpanRing::capacity + 100);
+    spans = ring->snapshot();
+    return check(spans.size() == SpanRing::capacity, "full ring") &&
+           check(spans.front().begin == 100, "wrapped oldest") &&
+           check(spans.back().begin == spans.size() + 99, "newest") &&
+           check(ordered(spans), "wrapped order") && ok;
+  }
+
+  bool profile_trace()
+  {
+    // Spans from two threads end up in one trace
+    auto& prof = kalika::profiler();
+    constexpr int per_thread = 50;
+    auto const record = [&] {
+      for (int i = 0; i < per_thread; i++) {
+        auto const begin = prof.now();
+        prof.ring().push({"work", begin, prof.now()});
+      }
+    };
+    record();
+    std::jthread(record).join();
+
+    std::ostringstream out;
+    prof.write_trace(out);
+    auto const trace = out.str();
+    JsonReader reader{trace};
+    bool const valid = reader.value() && reader.done();
+    // The reader itself must catch a cut trace
+    JsonReader cut{std::string_view(trace).substr(0, trace.size() / 2)};
+    bool const rejects = !(cut.value() && cut.done());
+
+    size_t events = 0;
+    for (auto pos = trace.find("\"ph\": \"X\""); pos != std::string::npos;
+         pos = trace.find("\"ph\": \"X\"", pos + 1)) {
+      events++;
+    }
+    return check(rejects, "cut trace rejected") &&
+           check(valid, "well-formed JSON") &&
+           check(trace.find("\"traceEvents\"") != std::string::npos,
+                 "event list") &&
+           check(events >= 2 * per_thread, "every span") &&
+           check(trace.find("\"tid\": 1") != std::string::npos,
+                 "second thread");
+  }
+}  //namespace
+
+int main(int argc, char** argv)
+{
+  std::unordered_map<std::string_view, std::function<bool()>> const tests{
+    {"pool_acquire", pool_acquire},
+    {"pool_release", pool_release},
+    {"pool_stale_handle", pool_stale_handle},
+    {"pool_acquire_bulk", pool_acquire_bulk},
+    {"pool_prewarm", pool_prewarm},
+    {"kinematics_simd", kinematics_simd},
+    {"homing_agrees", homing_agrees},
+    {"kinematics_swap_remove", kinematics_swap_remove},
+    {"kinematics_straight", kinematics_straight},
+    {"behaviour_dispatch", behaviour_dispatch},
+    {"event_bus_swap", event_bus_swap},
+    {"collision_broadphase", collision_broadphase},
+    {"targeting_nearest", targeting_nearest},
+    {"jobs_parallel_for", jobs_parallel_for},
+    {"jobs_deterministic", jobs_deterministic},
+    {"wave_parse", wave_parse},
+    {"wave_scheduler", wave_scheduler},
+    {"input_log", input_log},
+    {"snapshot_format", snapshot_format},
+    {"fire_timers", fire_timers},
+    {"rewind_buffer", rewind_buffer},
+    {"animation_clock", animation_clock},
+    {"particles_step", particles_step},
+    {"log_channel", log_channel},
+    {"fixed_step", fixed_step},
+    {"frame_stats", frame_stats},
+    {"span_ring", span_ring},
+    {"profile_trace", profile_trace},
+  };
+
+  if (argc < 2 || !tests.contains(argv[1])) {
+    std::cerr << "Unknown test\n";
+    return EXIT_FAILURE;
+  }
+
+  return tests.at(argv[1])() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
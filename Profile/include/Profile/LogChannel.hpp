@@ -0,0 +1,150 @@
+#ifndef LOG_CHANNEL_H
+#define LOG_CHANNEL_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string_view>
+#include <utility>
+
+namespace kalika
+{
+  /**
+   * @brief Bounded queue of short log messages, written from any thread
+   * and read by one
+   *
+   * Messages are formatted straight into preallocated slots, so neither
+   * side ever allocates or locks. Writers claim a slot by bumping the
+   * head; the reader takes slots back in order once they are published.
+   * A full channel drops new messages and counts them. Longer messages
+   * are cut to message_size.
+   */
+  struct LogChannel {
+    static constexpr std::size_t capacity = 64;
+    static constexpr std::size_t message_size = 116;
+    static_assert((capacity & (capacity - 1)) == 0);
+
+    // Constructor
+    LogChannel();
+
+    LogChannel(LogChannel const&) = delete;
+    LogChannel& operator=(LogChannel const&) = delete;
+
+    /**
+     * @brief Queue a message. Returns false if the channel was full.
+     */
+    bool push(std::string_view text)
+    {
+      return this->write([&](char* out) {
+        auto const size = std::min(text.size(), message_size);
+        std::copy_n(text.data(), size, out);
+        return size;
+      });
+    }
+
+    /**
+     * @brief Format a message in place. Returns false if the channel
+     * was full.
+     */
+    template<typename... Args>
+    bool print(std::format_string<Args...> fmt, Args&&... args)
+    {
+      return this->write([&](char* out) {
+        auto const result = std::format_to_n(
+          out, message_size, fmt, std::forward<Args>(args)...
+        );
+        return static_cast<std::size_t>(result.out - out);
+      });
+    }
+
+    /**
+     * @brief Hand every published message to func, oldest first.
+     * Returns the number of messages read. Only one thread may read.
+     */
+    template<typename Func> std::size_t drain(Func&& func)
+    {
+      std::size_t count = 0;
+      for (;; count++) {
+        auto& slot = this->slots_[this->tail_ & (capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) !=
+            this->tail_ + 1) {
+          return count;
+        }
+        func(std::string_view(slot.text.data(), slot.length));
+        // Hand the slot back to writers one lap ahead
+        slot.sequence.store(
+          this->tail_ + capacity, std::memory_order_release
+        );
+        this->tail_++;
+      }
+    }
+
+    /**
+     * @brief Messages lost to a full channel
+     */
+    std::size_t dropped() const
+    {
+      return this->dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /**
+     * @brief Preallocated message, two cache lines long
+     */
+    struct alignas(64) Slot {
+      // Position the slot waits for: a writer claims it at its
+      // position, the reader takes it at position + 1
+      std::atomic<std::size_t> sequence;
+      std::uint32_t length = 0;
+      std::array<char, message_size> text{};
+    };
+    static_assert(sizeof(Slot) == 128);
+
+    std::array<Slot, capacity> slots_;
+    // Next position to write, shared by every writer
+    alignas(64) std::atomic<std::size_t> head_ = 0;
+    // Next position to read, owned by the reader
+    alignas(64) std::size_t tail_ = 0;
+    std::atomic<std::size_t> dropped_ = 0;
+
+    // Claim a slot, let fill write the text and publish it
+    template<typename Fill> bool write(Fill&& fill)
+    {
+      auto pos = this->head_.load(std::memory_order_relaxed);
+      Slot* slot = nullptr;
+      for (;;) {
+        slot = &this->slots_[pos & (capacity - 1)];
+        auto const seq = slot->sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+          if (this->head_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed
+              )) {
+            break;
+          }
+        }
+        // The reader has not taken the slot back yet
+        else if (seq < pos) {
+          this->dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        else {
+          pos = this->head_.load(std::memory_order_relaxed);
+        }
+      }
+
+      slot->length = static_cast<std::uint32_t>(fill(slot->text.data()));
+      slot->sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+  };
+
+  /**
+   * @brief The process-wide log channel, shown in the window overlay
+   */
+  LogChannel& log_channel();
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace kalika
+{
+  /**
+   * @brief A timed section of code. Times are in nanoseconds since the
+   * profiler started.
+   */
+  struct Span {
+    // Static string naming the section
+    char const* name;
+    std::uint64_t begin;
+    std::uint64_t end;
+  };
+
+  /**
+   * @brief Fixed size ring of spans written by a single thread
+   *
+   * The owning thread pushes without locking; readers take a snapshot
+   * and drop whatever the writer overwrote while they were copying.
+   */
+  struct SpanRing {
+    static constexpr std::size_t capacity = 1UL << 14;
+
+    // Small id for the trace, in order of registration
+    std::uint32_t thread;
+
+    SpanRing(std::uint32_t tid) : thread(tid) {}
+
+    /**
+     * @brief Record a span. Only called by the owning thread.
+     */
+    void push(Span const& span)
+    {
+      auto const head = this->head_.load(std::memory_order_relaxed);
+      this->spans_[head & (capacity - 1)] = span;
+      this->head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy of the most recent spans, oldest first
+     */
+    std::vector<Span> snapshot() const;
+
+  private:
+    std::array<Span, capacity> spans_{};
+    std::atomic<std::uint64_t> head_ = 0;
+  };
+
+  /**
+   * @brief Frame time percentiles over the recent window, in seconds
+   */
+  struct FrameStats {
+    float p50 = 0.F;
+    float p95 = 0.F;
+    float p99 = 0.F;
+    float max = 0.F;
+  };
+
+  /**
+   * @brief Collects spans from every thread and frame times from the
+   * game loop
+   */
+  struct Profiler {
+    // Frames kept for the percentiles
+    static constexpr std::size_t frame_window = 240;
+
+    Profiler() : epoch_(Clock::now()) {}
+
+    /**
+     * @brief Nanoseconds since the profiler started
+     */
+    std::uint64_t now() const
+    {
+      return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - this->epoch_
+        )
+          .count()
+      );
+    }
+
+    /**
+     * @brief Ring of the calling thread, registered on first use
+     */
+    SpanRing& ring();
+
+    /**
+     * @brief Record the length of a frame. Called by the game loop.
+     */
+    void end_frame(float seconds);
+
+    /**
+     * @brief Percentiles of the recent frame times
+     */
+    FrameStats frame_stats() const;
+
+    /**
+     * @brief Write every recorded span in Chrome trace-event format
+     */
+    void write_trace(std::ostream& out) const;
+
+    bool write_trace(std::filesystem::path const& path) const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point epoch_;
+
+    // Rings live as long as the profiler, even after their thread exits
+    mutable std::mutex rings_mutex_;
+    std::vector<std::unique_ptr<SpanRing>> rings_;
+
+    // Recent frame times, written by the game loop only
+    std::array<float, frame_window> frames_{};
+    std::size_t frame_count_ = 0;
+  };
+
+  /**
+   * @brief The process-wide profiler
+   */
+  Profiler& profiler();
+
+  /**
+   * @brief Records a span from construction to destruction
+   */
+  struct ScopedSpan {
+    ScopedSpan(char const* name) :
+      name_(name), begin_(profiler().now())
+    {}
+
+    ~ScopedSpan()
+    {
+      auto& prof = profiler();
+      prof.ring().push({this->name_, this->begin_, prof.now()});
+    }
+
+    ScopedSpan(ScopedSpan const&) = delete;
+    ScopedSpan& operator=(ScopedSpan const&) = delete;
+
+  private:
+    char const* name_;
+    std::uint64_t begin_;
+  };
+}  //namespace kalika
+
+// Time the rest of the enclosing scope. Compiles to nothing unless
+// KALIKA_PROFILE is defined.
+#ifdef KALIKA_PROFILE
+  #define KALIKA_PROFILE_JOIN_(a, b) a##b
+  #define KALIKA_PROFILE_JOIN(a, b) KALIKA_PROFILE_JOIN_(a, b)
+  #define KALIKA_PROFILE_SCOPE(name) \
+    ::kalika::ScopedSpan const KALIKA_PROFILE_JOIN(span_, __LINE__)(name)
+#else
+  #define KALIKA_PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
+
+#endif
@@ -0,0 +1,18 @@
+#include <Profile/LogChannel.hpp>
+
+namespace kalika
+{
+  // Each slot first waits for the write at its own position
+  LogChannel::LogChannel()
+  {
+    for (std::size_t idx = 0; idx < capacity; idx++) {
+      this->slots_[idx].sequence.store(idx, std::memory_order_relaxed);
+    }
+  }
+
+  LogChannel& log_channel()
+  {
+    static LogChannel instance;
+    return instance;
+  }
+}  //namespace kalika
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+#include <Profile/Profiler.hpp>
+
+namespace kalika
+{
+  // ====== Span ring ====== //
+  // Copy the live part of the ring
+  std::vector<Span> SpanRing::snapshot() const
+  {
+    auto const head = this->head_.load(std::memory_order_acquire);
+    auto const first = (head > capacity) ? head - capacity : 0UL;
+
+    std::vector<Span> spans;
+    spans.reserve(head - first);
+    for (auto idx = first; idx < head; idx++) {
+      spans.push_back(this->spans_[idx & (capacity - 1)]);
+    }
+
+    // Entries the writer lapped during the copy may be torn
+    auto const after = this->head_.load(std::memory_order_acquire);
+    auto const lapped = (after > capacity) ? after - capacity : 0UL;
+    if (lapped > first) {
+      auto const torn = std::min<std::size_t>(lapped - first, spans.size());
+      spans.erase(spans.begin(), spans.begin() + torn);
+    }
+    return spans;
+  }
+
+  // ====== Profiler ====== //
+  // Find or register the ring of this thread
+  SpanRing& Profiler::ring()
+  {
+    thread_local SpanRing* local = nullptr;
+    if (local == nullptr) {
+      std::scoped_lock const lock(this->rings_mutex_);
+      auto const tid = static_cast<std::uint32_t>(this->rings_.size());
+      local =
+        this->rings_.emplace_back(std::make_unique<SpanRing>(tid)).get();
+    }
+    return *local;
+  }
+
+  // Record a frame
+  void Profiler::end_frame(float seconds)
+  {
+    this->frames_[this->frame_count_ % frame_window] = seconds;
+    this->frame_count_++;
+  }
+
+  // Percentiles over the window
+  FrameStats Profiler::frame_stats() const
+  {
+    auto const count = std::min(this->frame_count_, frame_window);
+    if (count == 0) {
+      return {};
+    }
+
+    std::array<float, frame_window> sorted = this->frames_;
+    std::sort(sorted.begin(), sorted.begin() + count);
+    auto const at = [&](float q) {
+      return sorted[static_cast<std::size_t>(q * (count - 1))];
+    };
+
+    return {
+      .p50 = at(0.50F),
+      .p95 = at(0.95F),
+      .p99 = at(0.99F),
+      .max = sorted[count - 1],
+    };
+  }
+
+  // Chrome trace-event JSON, timestamps in microseconds
+  void Profiler::write_trace(std::ostream& out) const
+  {
+    std::scoped_lock const lock(this->rings_mutex_);
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for (auto const& ring : this->rings_) {
+      for (auto const& span : ring->snapshot()) {
+        out << std::format(
+          "{}{{\"name\": \"{}\", \"ph\": \"X\", \"pid\": 1, "
+          "\"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+          first ? "" : ",\n",
+          span.name,
+          ring->thread,
+          static_cast<double>(span.begin) / 1e3,
+          static_cast<double>(span.end - span.begin) / 1e3
+        );
+        first = false;
+      }
+    }
+    out << "\n]}\n";
+  }
+
+  bool Profiler::write_trace(std::filesystem::path const& path) const
+  {
+    std::ofstream file(path);
+    if (!file) {
+      return false;
+    }
+    this->write_trace(file);
+    return static_cast<bool>(file);
+  }
+
+  // Global profiler
+  Profiler& profiler()
+  {
+    static Profiler instance;
+    return instance;
+  }
+}  //namespace kalika
@@ -0,0 +1,87 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <Resource/Sprites.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Location of a sprite sheet inside the atlas
+   */
+  struct SpriteRegion {
+    // Atlas page holding the sheet
+    std::size_t page = 0;
+    // Whole sheet within the page
+    sf::IntRect rect;
+    // Layout of the animation strip
+    sf::Vector2i frame_size;
+    unsigned frames = 1;
+    // Texture rect of every frame, laid out when the atlas is built
+    std::array<sf::IntRect, max_frames> frame_rects{};
+
+    /**
+     * @brief Texture rect of a frame
+     */
+    sf::IntRect const& frame(unsigned idx) const
+    {
+      return this->frame_rects[idx % this->frames];
+    }
+  };
+
+  /**
+   * @brief Texture atlas holding every sprite sheet
+   *
+   * Sheets are shelf-packed into as few pages as fit in page_size.
+   */
+  struct Atlas {
+    static constexpr unsigned page_size = 1024U;
+    // Transparent gap between sheets to avoid bleeding
+    static constexpr unsigned padding = 1U;
+
+    using Images = std::array<sf::Image, sprite_count>;
+
+    /**
+     * @brief Pack the decoded sheets, indexed by SpriteId. Without
+     * upload, only the layout is built and pages stay empty textures.
+     */
+    void build(Images const& images, bool upload = true);
+
+    /**
+     * @brief Region of the sprite within the atlas
+     */
+    SpriteRegion const& region(SpriteId id) const
+    {
+      return this->regions_[static_cast<std::size_t>(id)];
+    }
+
+    /**
+     * @brief Atlas page holding the sprite
+     */
+    sf::Texture const& texture(SpriteId id) const
+    {
+      return this->pages_[this->region(id).page];
+    }
+
+    /**
+     * @brief Number of atlas pages
+     */
+    std::size_t page_count() const { return this->pages_.size(); }
+
+  private:
+    std::array<SpriteRegion, sprite_count> regions_;
+    std::vector<sf::Texture> pages_;
+  };
+
+  /**
+   * @brief The atlas owned by the resource manager
+   */
+  Atlas const& atlas();
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef RESOURCES_H
+#define RESOURCES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+
+#include <Resource/Atlas.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Identifier of every font
+   */
+  enum class FontId : std::uint8_t { Tuffy, Count };
+
+  inline constexpr std::size_t font_count =
+    static_cast<std::size_t>(FontId::Count);
+
+  // Font files indexed by FontId
+  inline constexpr std::array<char const*, font_count> font_paths{
+    "resources/tuffy.ttf",
+  };
+
+  /**
+   * @brief Decode time of a single asset
+   */
+  struct LoadStat {
+    char const* path;
+    float seconds;
+    bool ok;
+  };
+
+  /**
+   * @brief Owns every asset of the game
+   *
+   * Each asset is decoded exactly once, in parallel on worker threads.
+   * Textures are then uploaded into the atlas on the calling thread.
+   * Assets are looked up through SpriteId and FontId handles.
+   */
+  struct ResourceManager {
+    // Upload textures to the GPU. Cleared by headless runs before the
+    // manager is first used.
+    inline static bool upload_textures = true;
+
+    // Decode everything up front
+    ResourceManager();
+
+    /**
+     * @brief Atlas holding every sprite sheet
+     */
+    Atlas const& atlas() const { return this->atlas_; }
+
+    /**
+     * @brief Font with the given id
+     */
+    sf::Font const& font(FontId id) const
+    {
+      return this->fonts_[static_cast<std::size_t>(id)];
+    }
+
+    /**
+     * @brief Per-asset decode times
+     */
+    std::vector<LoadStat> const& stats() const { return this->stats_; }
+
+    /**
+     * @brief Wall time taken to load everything
+     */
+    float load_time() const { return this->load_time_; }
+
+    /**
+     * @brief Record the time from startup to the first presented frame.
+     * Only the first call counts.
+     */
+    void mark_first_frame();
+
+    /**
+     * @brief Time from startup to the first frame, once presented
+     */
+    std::optional<float> first_frame() const { return this->first_frame_; }
+
+    /**
+     * @brief Write the load metrics
+     */
+    void report(std::ostream& out) const;
+
+  private:
+    sf::Clock startup_;
+    Atlas atlas_;
+    std::array<sf::Font, font_count> fonts_;
+
+    // Metrics
+    std::vector<LoadStat> stats_;
+    float load_time_ = 0.F;
+    std::optional<float> first_frame_;
+  };
+
+  /**
+   * @brief The process-wide resource manager, loaded on first use
+   */
+  ResourceManager& resources();
+}  //namespace kalika
+
+#endif
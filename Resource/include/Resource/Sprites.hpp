@@ -0,0 +1,71 @@
+#ifndef SPRITES_H
+#define SPRITES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace kalika
+{
+  /**
+   * @brief Identifier of every sprite sheet packed into the atlas
+   */
+  enum class SpriteId : std::uint8_t {
+    Bullet,
+    Player,
+    Reticle,
+    Chaser,
+    Dasher,
+    Ship1,
+    Ship2,
+    Ship3,
+    Ship4,
+    Ship5,
+    Count
+  };
+
+  /**
+   * @brief Source image and frame layout of a sprite sheet
+   */
+  struct SpriteSheet {
+    char const* path;
+    // Animation frames, laid out horizontally
+    unsigned frames = 1;
+  };
+
+  inline constexpr std::size_t sprite_count =
+    static_cast<std::size_t>(SpriteId::Count);
+
+  // Sprite sheets indexed by SpriteId
+  inline constexpr std::array<SpriteSheet, sprite_count> sprite_sheets{{
+    {"resources/bullet.png", 1},
+    {"resources/player.png", 1},
+    {"resources/reticle.png", 1},
+    {"resources/Enemies/chaser.png", 4},
+    {"resources/Enemies/dasher.png", 2},
+    {"resources/SpaceShips/Ship_1.png", 1},
+    {"resources/SpaceShips/Ship_2.png", 1},
+    {"resources/SpaceShips/Ship_3.png", 1},
+    {"resources/SpaceShips/Ship_4.png", 1},
+    {"resources/SpaceShips/Ship_5.png", 1},
+  }};
+
+  // Longest animation strip of any sheet
+  inline constexpr unsigned max_frames = [] {
+    unsigned most = 1;
+    for (auto const& sheet : sprite_sheets) {
+      most = (sheet.frames > most) ? sheet.frames : most;
+    }
+    return most;
+  }();
+
+  /**
+   * @brief Sprite sheet of the given sprite
+   */
+  constexpr SpriteSheet const& sheet(SpriteId id)
+  {
+    return sprite_sheets[static_cast<std::size_t>(id)];
+  }
+}  //namespace kalika
+
+#endif
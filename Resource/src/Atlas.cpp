@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <numeric>
+
+#include <Resource/Atlas.hpp>
+#include <Resource/Resources.hpp>
+
+namespace kalika
+{
+  // Shelf-pack the sheets into pages
+  void Atlas::build(Images const& images, bool upload)
+  {
+    // Place taller sheets first so shelves stay tight
+    std::array<std::size_t, sprite_count> order{};
+    std::iota(order.begin(), order.end(), 0UL);
+    std::ranges::stable_sort(order, [&images](auto a, auto b) {
+      return images[a].getSize().y > images[b].getSize().y;
+    });
+
+    // 1. Lay out the sheets
+    std::vector<sf::Vector2u> extents(1);
+    sf::Vector2u cursor;
+    unsigned shelf = 0;
+    for (auto idx : order) {
+      auto const size =
+        images[idx].getSize() + sf::Vector2u(padding, padding);
+
+      // Next shelf, then next page
+      if (cursor.x + size.x > page_size) {
+        cursor = {0U, cursor.y + shelf};
+        shelf = 0;
+      }
+      if (cursor.y + size.y > page_size) {
+        extents.emplace_back();
+        cursor = {};
+        shelf = 0;
+      }
+
+      auto& region = this->regions_[idx];
+      auto const frames = std::max(sprite_sheets[idx].frames, 1U);
+      region.page = extents.size() - 1;
+      region.rect = {
+        sf::Vector2i(cursor), sf::Vector2i(images[idx].getSize())
+      };
+      region.frames = frames;
+      region.frame_size = {
+        region.rect.size.x / static_cast<int>(frames), region.rect.size.y
+      };
+      for (unsigned frame = 0; frame < frames; frame++) {
+        auto const offset = static_cast<int>(frame) * region.frame_size.x;
+        region.frame_rects[frame] = {
+          {region.rect.position.x + offset, region.rect.position.y},
+          region.frame_size
+        };
+      }
+
+      auto& extent = extents.back();
+      extent.x = std::max(extent.x, cursor.x + size.x);
+      extent.y = std::max(extent.y, cursor.y + size.y);
+      cursor.x += size.x;
+      shelf = std::max(shelf, size.y);
+    }
+
+    // Headless runs have no GL context to upload to
+    this->pages_.clear();
+    if (!upload) {
+      this->pages_.resize(extents.size());
+      return;
+    }
+
+    // 2. Copy the sheets into page images and upload them
+    std::vector<sf::Image> pages;
+    for (auto extent : extents) {
+      pages.emplace_back(extent, sf::Color::Transparent);
+    }
+    for (std::size_t idx = 0; idx < sprite_count; idx++) {
+      auto const& region = this->regions_[idx];
+      (void)pages[region.page].copy(
+        images[idx], sf::Vector2u(region.rect.position)
+      );
+    }
+
+    for (auto const& page : pages) {
+      auto& texture = this->pages_.emplace_back();
+      (void)texture.loadFromImage(page);
+      texture.setSmooth(false);
+    }
+  }
+
+  // Global atlas
+  Atlas const& atlas()
+  {
+    return resources().atlas();
+  }
+}  //namespace kalika
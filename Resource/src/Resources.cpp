@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <functional>
+#include <thread>
+
+#include <Resource/Resources.hpp>
+
+namespace kalika
+{
+  // Load every asset
+  ResourceManager::ResourceManager()
+  {
+    Atlas::Images images;
+
+    // One task per asset: sprite sheets first, then fonts
+    std::vector<std::function<bool()>> tasks;
+    for (std::size_t idx = 0; idx < sprite_count; idx++) {
+      tasks.emplace_back([&images, idx] {
+        return images[idx].loadFromFile(sprite_sheets[idx].path);
+      });
+      this->stats_.push_back({sprite_sheets[idx].path, 0.F, false});
+    }
+    for (std::size_t idx = 0; idx < font_count; idx++) {
+      tasks.emplace_back([this, idx] {
+        return this->fonts_[idx].openFromFile(font_paths[idx]);
+      });
+      this->stats_.push_back({font_paths[idx], 0.F, false});
+    }
+
+    // Workers pull tasks until none are left
+    std::atomic<std::size_t> next = 0;
+    auto worker = [&] {
+      for (auto idx = next++; idx < tasks.size(); idx = next++) {
+        sf::Clock timer;
+        this->stats_[idx].ok = tasks[idx]();
+        this->stats_[idx].seconds = timer.getElapsedTime().asSeconds();
+      }
+    };
+
+    auto const count = std::clamp<std::size_t>(
+      std::thread::hardware_concurrency(), 1UL, tasks.size()
+    );
+    {
+      std::vector<std::jthread> workers;
+      for (std::size_t i = 1; i < count; i++) {
+        workers.emplace_back(worker);
+      }
+      worker();
+    }
+
+    // Texture upload stays on the calling thread
+    this->atlas_.build(images, upload_textures);
+    this->load_time_ = this->startup_.getElapsedTime().asSeconds();
+  }
+
+  // Time to first frame
+  void ResourceManager::mark_first_frame()
+  {
+    if (!this->first_frame_) {
+      this->first_frame_ = this->startup_.getElapsedTime().asSeconds();
+    }
+  }
+
+  // Print metrics
+  void ResourceManager::report(std::ostream& out) const
+  {
+    for (auto const& stat : this->stats_) {
+      out << std::format(
+        "{:<36} {:>8.3f} ms{}\n",
+        stat.path,
+        stat.seconds * 1000.F,
+        stat.ok ? "" : " (failed)"
+      );
+    }
+    out << std::format(
+      "Assets loaded in {:.3f} ms ({} atlas pages)\n",
+      this->load_time_ * 1000.F,
+      this->atlas_.page_count()
+    );
+    if (this->first_frame_) {
+      out << std::format(
+        "Time to first frame: {:.3f} ms\n", *this->first_frame_ * 1000.F
+      );
+    }
+  }
+
+  // Global resource manager
+  ResourceManager& resources()
+  {
+    static ResourceManager instance;
+    return instance;
+  }
+}  //namespace kalika
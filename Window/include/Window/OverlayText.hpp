@@ -0,0 +1,86 @@
+#ifndef OVERLAY_TEXT_H
+#define OVERLAY_TEXT_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Fixed set of text lines drawn in one call
+   *
+   * Each line keeps its glyph quads, laid out again only when its text
+   * changes. Moving a line or changing another one only shifts vertices
+   * already built into the shared array. Text is taken as ASCII; a '\n'
+   * starts a new row within the line.
+   */
+  struct OverlayText {
+    // Constructor
+    OverlayText(
+      sf::Font const& font, size_t lines, unsigned size, sf::Color colour
+    );
+
+    /**
+     * @brief Set the text of a line. Glyphs are laid out only if it
+     * changed.
+     */
+    void set(size_t line, std::string_view text);
+
+    /**
+     * @brief Place the top left corner of a line
+     */
+    void move(size_t line, sf::Vector2f position);
+
+    /**
+     * @brief Change the character size, laying out every line again
+     */
+    void set_character_size(unsigned size);
+
+    /**
+     * @brief Draw every line with a single call
+     */
+    void draw(sf::RenderTarget& target);
+
+    std::string_view text(size_t line) const
+    {
+      return this->lines_[line].text;
+    }
+
+    size_t lines() const { return this->lines_.size(); }
+
+    /**
+     * @brief Lines laid out so far, to check that unchanged text costs
+     * nothing
+     */
+    size_t layouts() const { return this->layouts_; }
+
+  private:
+    /**
+     * @brief Text and glyph quads of one line, relative to its corner
+     */
+    struct Line {
+      std::string text;
+      sf::Vector2f position;
+      std::vector<sf::Vertex> glyphs;
+    };
+
+    sf::Font const* font_;
+    unsigned size_;
+    sf::Color colour_;
+
+    std::vector<Line> lines_;
+    // Every line at its position, rebuilt when a line changes or moves
+    std::vector<sf::Vertex> vertices_;
+    bool dirty_ = false;
+    size_t layouts_ = 0;
+
+    // Build the glyph quads of a line
+    void layout(Line& line);
+  };
+}  //namespace kalika
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Columns of particles sharing a texture rect and a tint
+   */
+  struct ParticleLayer {
+    sf::Texture const* texture;
+    sf::FloatRect rect;
+    sf::Color colour;
+    // Side of a quad at full fade
+    float size;
+    // Centres, and 1 down to 0 over a particle's life
+    std::span<float const> x;
+    std::span<float const> y;
+    std::span<float const> fade;
+  };
+
+  /**
+   * @brief Batches sprites into one vertex array per texture
+   *
+   * Each sprite becomes a quad (two triangles) with its full transform
+   * and texture rect baked in, and every texture is submitted with a
+   * single draw call. Vertex arrays persist across frames and only grow.
+   */
+  struct SpriteBatch {
+    /**
+     * @brief Start a new frame. Keeps the allocated vertices.
+     */
+    void clear();
+
+    /**
+     * @brief Queue a sprite. Fully transparent sprites are skipped.
+     */
+    void add(sf::Sprite const& sprite);
+
+    /**
+     * @brief Queue a layer of particles as quads shrinking and fading
+     * out with their life. Straight from the columns, without sprites.
+     */
+    void add(ParticleLayer const& layer);
+
+    /**
+     * @brief Submit every texture group with one draw call each
+     */
+    void draw(sf::RenderTarget& target) const;
+
+    /**
+     * @brief Number of draw calls the next draw will issue
+     */
+    size_t draw_calls() const;
+
+    /**
+     * @brief Vertices queued for a texture, two triangles per quad
+     */
+    std::span<sf::Vertex const> vertices(sf::Texture const* texture) const;
+
+  private:
+    /**
+     * @brief Vertices sharing a texture
+     */
+    struct Group {
+      sf::Texture const* texture;
+      sf::VertexArray vertices{sf::PrimitiveType::Triangles};
+      size_t used = 0;
+    };
+
+    // Groups in order of first appearance
+    std::vector<Group> groups_;
+    // Group of the last sprite added
+    size_t last_ = 0;
+
+    // Find or create the group for a texture
+    Group& group(sf::Texture const* texture);
+  };
+}  //namespace kalika
+
+#endif
@@ -4,12 +4,18 @@
 #include <format>
 #include <functional>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Main.hpp>
 #include <SFML/System.hpp>
 
 #include <Event/GameEvent.hpp>
+#include <Resource/Resources.hpp>
+#include <Window/OverlayText.hpp>
+#include <Window/SpriteBatch.hpp>
 
 namespace kalika
 {
@@ -25,6 +31,11 @@ namespace kalika
      */
     bool is_active() { return this->window_.isOpen(); }
 
+    /**
+     * @brief Close the window, ending the game loop
+     */
+    void close() { this->window_.close(); }
+
     /**
      * @brief Draw all objects in the world
      *
@@ -33,29 +44,71 @@ namespace kalika
      */
     using SpriteRef = std::reference_wrapper<sf::Sprite const>;
     /**
-     * @brief Draw the sprites given
+     * @brief Draw the sprites given, then the particle layers, batched
+     * by texture
      */
-    void draw(std::vector<SpriteRef> const& sprites);
+    void draw(
+      std::vector<SpriteRef> const& sprites,
+      std::span<ParticleLayer const> particles = {}
+    );
     /**
      * @brief Handle user input through SFML events
      */
     void handle_input();
 
+    /**
+     * @brief Set the stats overlay drawn in the bottom left corner.
+     * F3 toggles it and F12 writes a Chrome trace of recent frames.
+     */
+    void set_overlay(std::string_view text)
+    {
+      // Assigning keeps the capacity, so a steady overlay never allocates
+      this->overlay_.assign(text);
+    }
+
+    /**
+     * @brief Turn publishing joystick input on the bus on or off. Off
+     * while a replay drives the player.
+     */
+    void set_input(bool enabled) { this->input_ = enabled; }
+
+    /**
+     * @brief Cap the frame rate, or uncap it with 0
+     */
+    void set_frame_limit(unsigned fps)
+    {
+      this->window_.setFramerateLimit(fps);
+    }
+
   private:
     // Window information
     sf::RenderWindow window_;
     sf::ContextSettings settings_;
 
-    // Log information
-    sf::Font const font_{"resources/tuffy.ttf"};
-    sf::Text log_text_{font_};
-    std::deque<std::string> logs_;
+    // Sprite batches, reused across frames
+    SpriteBatch batch_;
+
+    // Overlay rows: the log, then the stick readout and the stats
+    static constexpr size_t log_lines = 12;
+    static constexpr size_t stick_line = log_lines;
+    static constexpr size_t stats_line = log_lines + 1;
+    sf::Font const& font_ = resources().font(FontId::Tuffy);
+    OverlayText text_;
+    // Row of the oldest message, and rows in use
+    size_t log_head_ = 0;
+    size_t log_count_ = 0;
+
+    // Stats overlay
+    std::string overlay_;
+    bool show_overlay_ = true;
 
     // World info
     sf::Vector2f x_axis_;
 
     // Game Event Handler
     EventBus* bus_ = nullptr;
+    // Publish joystick input
+    bool input_ = true;
 
     // Remember stick positions
     sf::Vector2f l_strength_;
@@ -63,10 +116,8 @@ namespace kalika
 
     // ======== Helper functions ======== //
 
-    // Log to window
+    // Take new messages off the log channel and draw the overlay
     void log();
-    // Update logs
-    void update_log(std::string const& text);
 
     // Clamp deadzone
     template<typename T>
@@ -0,0 +1,116 @@
+#include <cstdint>
+
+#include <Window/OverlayText.hpp>
+
+namespace kalika
+{
+  // Constructor
+  OverlayText::OverlayText(
+    sf::Font const& font, size_t lines, unsigned size, sf::Color colour
+  ) :
+    font_(&font), size_(size), colour_(colour), lines_(lines)
+  {}
+
+  // Compare before laying anything out
+  void OverlayText::set(size_t line, std::string_view text)
+  {
+    auto& entry = this->lines_[line];
+    if (entry.text == text) {
+      return;
+    }
+    // Assigning keeps the capacity the line already had
+    entry.text.assign(text);
+    this->layout(entry);
+    this->dirty_ = true;
+  }
+
+  void OverlayText::move(size_t line, sf::Vector2f position)
+  {
+    auto& entry = this->lines_[line];
+    if (entry.position == position) {
+      return;
+    }
+    entry.position = position;
+    this->dirty_ = true;
+  }
+
+  void OverlayText::set_character_size(unsigned size)
+  {
+    if (this->size_ == size) {
+      return;
+    }
+    this->size_ = size;
+    for (auto& line : this->lines_) {
+      this->layout(line);
+    }
+    this->dirty_ = true;
+  }
+
+  // Merge the lines if any changed, then draw them at once
+  void OverlayText::draw(sf::RenderTarget& target)
+  {
+    if (this->dirty_) {
+      this->vertices_.clear();
+      for (auto const& line : this->lines_) {
+        for (auto vertex : line.glyphs) {
+          vertex.position += line.position;
+          this->vertices_.push_back(vertex);
+        }
+      }
+      this->dirty_ = false;
+    }
+    if (this->vertices_.empty()) {
+      return;
+    }
+    target.draw(
+      this->vertices_.data(),
+      this->vertices_.size(),
+      sf::PrimitiveType::Triangles,
+      sf::RenderStates(&this->font_->getTexture(this->size_))
+    );
+  }
+
+  // Same placement as sf::Text: rows start a character size down, at
+  // the baseline, and advance by the font's line spacing
+  void OverlayText::layout(Line& line)
+  {
+    this->layouts_++;
+    line.glyphs.clear();
+    auto const& font = *this->font_;
+    float const spacing = font.getLineSpacing(this->size_);
+
+    float x = 0.F;
+    auto y = static_cast<float>(this->size_);
+    std::uint32_t previous = 0;
+    for (char const ch : line.text) {
+      auto const code = static_cast<std::uint32_t>(
+        static_cast<unsigned char>(ch)
+      );
+      x += font.getKerning(previous, code, this->size_);
+      previous = code;
+      if (code == '\n') {
+        x = 0.F;
+        y += spacing;
+        continue;
+      }
+
+      auto const& glyph = font.getGlyph(code, this->size_, false);
+      if (code != ' ' && code != '\t') {
+        float const left = x + glyph.bounds.position.x;
+        float const top = y + glyph.bounds.position.y;
+        float const right = left + glyph.bounds.size.x;
+        float const bottom = top + glyph.bounds.size.y;
+        auto const rect = sf::FloatRect(glyph.textureRect);
+        auto const [u0, v0] = rect.position;
+        auto const [u1, v1] = rect.position + rect.size;
+
+        sf::Vertex const tl{{left, top}, this->colour_, {u0, v0}};
+        sf::Vertex const tr{{right, top}, this->colour_, {u1, v0}};
+        sf::Vertex const bl{{left, bottom}, this->colour_, {u0, v1}};
+        sf::Vertex const br{{right, bottom}, this->colour_, {u1, v1}};
+        line.glyphs.insert(line.glyphs.end(), {tl, bl, tr, tr, bl, br});
+      }
+      x += glyph.advance;
+    }
+  }
+}  //namespace kalika
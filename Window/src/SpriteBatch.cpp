@@ -0,0 +1,153 @@
+#include <cmath>
+#include <cstdint>
+
+#include <Window/SpriteBatch.hpp>
+
+namespace kalika
+{
+  // Reset vertex counts
+  void SpriteBatch::clear()
+  {
+    for (auto& group : this->groups_) {
+      group.used = 0;
+    }
+  }
+
+  // Add a sprite to the batch
+  void SpriteBatch::add(sf::Sprite const& sprite)
+  {
+    sf::Color const colour = sprite.getColor();
+    if (colour.a == 0) {
+      return;
+    }
+
+    // Grow the persistent vertex array if needed
+    Group& batch = this->group(&sprite.getTexture());
+    if (batch.used + 6 > batch.vertices.getVertexCount()) {
+      batch.vertices.resize((batch.used + 6) * 2);
+    }
+
+    // Corners in local space and texture space
+    auto const rect = sf::FloatRect(sprite.getTextureRect());
+    float const w = std::fabs(rect.size.x);
+    float const h = std::fabs(rect.size.y);
+    auto const [u0, v0] = rect.position;
+    auto const [u1, v1] = rect.position + rect.size;
+
+    sf::Transform const& tf = sprite.getTransform();
+    sf::Vertex const tl{tf.transformPoint({0.F, 0.F}), colour, {u0, v0}};
+    sf::Vertex const tr{tf.transformPoint({w, 0.F}), colour, {u1, v0}};
+    sf::Vertex const bl{tf.transformPoint({0.F, h}), colour, {u0, v1}};
+    sf::Vertex const br{tf.transformPoint({w, h}), colour, {u1, v1}};
+
+    // Two triangles per quad
+    sf::Vertex* quad = &batch.vertices[batch.used];
+    quad[0] = tl;
+    quad[1] = bl;
+    quad[2] = tr;
+    quad[3] = tr;
+    quad[4] = bl;
+    quad[5] = br;
+    batch.used += 6;
+  }
+
+  // Add axis-aligned quads for a whole layer
+  void SpriteBatch::add(ParticleLayer const& layer)
+  {
+    if (layer.x.empty()) {
+      return;
+    }
+
+    // Grow once for the whole layer
+    Group& batch = this->group(layer.texture);
+    size_t const needed = batch.used + (layer.x.size() * 6);
+    if (needed > batch.vertices.getVertexCount()) {
+      batch.vertices.resize(needed * 2);
+    }
+
+    auto const [u0, v0] = layer.rect.position;
+    auto const [u1, v1] = layer.rect.position + layer.rect.size;
+    float const alpha = layer.colour.a;
+    sf::Vertex* quad = &batch.vertices[batch.used];
+    for (size_t i = 0; i < layer.x.size(); i++, quad += 6) {
+      float const fade = layer.fade[i];
+      float const half = layer.size * fade / 2.F;
+      sf::Color colour = layer.colour;
+      colour.a = static_cast<std::uint8_t>(alpha * fade);
+
+      float const left = layer.x[i] - half;
+      float const right = layer.x[i] + half;
+      float const top = layer.y[i] - half;
+      float const bottom = layer.y[i] + half;
+      sf::Vertex const tl{{left, top}, colour, {u0, v0}};
+      sf::Vertex const tr{{right, top}, colour, {u1, v0}};
+      sf::Vertex const bl{{left, bottom}, colour, {u0, v1}};
+      sf::Vertex const br{{right, bottom}, colour, {u1, v1}};
+      quad[0] = tl;
+      quad[1] = bl;
+      quad[2] = tr;
+      quad[3] = tr;
+      quad[4] = bl;
+      quad[5] = br;
+    }
+    batch.used = needed;
+  }
+
+  // Draw each texture in one call
+  void SpriteBatch::draw(sf::RenderTarget& target) const
+  {
+    for (auto const& batch : this->groups_) {
+      if (batch.used == 0) {
+        continue;
+      }
+      target.draw(
+        &batch.vertices[0],
+        batch.used,
+        sf::PrimitiveType::Triangles,
+        sf::RenderStates(batch.texture)
+      );
+    }
+  }
+
+  // Count non-empty groups
+  size_t SpriteBatch::draw_calls() const
+  {
+    size_t calls = 0;
+    for (auto const& batch : this->groups_) {
+      calls += (batch.used > 0) ? 1 : 0;
+    }
+    return calls;
+  }
+
+  // Queued part of the texture's group
+  std::span<sf::Vertex const>
+  SpriteBatch::vertices(sf::Texture const* texture) const
+  {
+    for (auto const& batch : this->groups_) {
+      if (batch.texture == texture && batch.used > 0) {
+        return {&batch.vertices[0], batch.used};
+      }
+    }
+    return {};
+  }
+
+  // Find the group for a texture
+  SpriteBatch::Group& SpriteBatch::group(sf::Texture const* texture)
+  {
+    // Consecutive sprites usually share a texture
+    if (this->last_ < this->groups_.size() &&
+        this->groups_[this->last_].texture == texture) {
+      return this->groups_[this->last_];
+    }
+
+    for (size_t idx = 0; idx < this->groups_.size(); idx++) {
+      if (this->groups_[idx].texture == texture) {
+        this->last_ = idx;
+        return this->groups_[idx];
+      }
+    }
+
+    this->last_ = this->groups_.size();
+    return this->groups_.emplace_back(Group{.texture = texture});
+  }
+}  //namespace kalika
@@ -1,3 +1,7 @@
+#include <array>
+
+#include <Profile/LogChannel.hpp>
+#include <Profile/Profiler.hpp>
 #include <Window/Window.hpp>
 
 namespace kalika
@@ -12,6 +16,8 @@ namespace kalika
       title,
       sf::Style::Titlebar | sf::Style::Close
     ),
+    // Overlay text
+    text_(font_, log_lines + 2, dimensions.y / 50U, sf::Color::Yellow),
     // World axis
     x_axis_({1.F, 0.F}),
     bus_(bus)
@@ -24,16 +30,12 @@ namespace kalika
       )
     );
     this->window_.setKeyRepeatEnabled(false);
-    this->log_text_.setCharacterSize(dimensions.y / 50U);
 
     // Anti-aliasing
     this->settings_.antiAliasingLevel = 8;
 
-    // Logs configuration
-    this->log_text_.setFillColor(sf::Color::Yellow);
-
     if (sf::Joystick::isConnected(0)) {
-      this->update_log("Joystick 0 connected");
+      log_channel().push("Joystick 0 connected");
     }
   }
 
@@ -46,60 +48,91 @@ namespace kalika
   }
 
   // Run the SFMLWindow
-  void SFMLWindow::draw(std::vector<SpriteRef> const& sprites)
+  void SFMLWindow::draw(
+    std::vector<SpriteRef> const& sprites,
+    std::span<ParticleLayer const> particles
+  )
   {
     // Clear display before drawing
     this->window_.clear();
 
-    // Draw the collection of sprites provided
-    for (auto sprite : sprites) {
-      this->window_.draw(sprite);
+    // Draw the collection of sprites provided, one call per texture
+    {
+      KALIKA_PROFILE_SCOPE("batch");
+      this->batch_.clear();
+      for (auto sprite : sprites) {
+        this->batch_.add(sprite);
+      }
+      for (auto const& layer : particles) {
+        this->batch_.add(layer);
+      }
+      this->batch_.draw(this->window_);
     }
 
     // Log messages to window
     this->log();
 
     // Render window
+    KALIKA_PROFILE_SCOPE("present");
     this->window_.display();
   }
 
-  // Log messages
+  // Draw the log and the overlay lines
   void SFMLWindow::log()
   {
-    // Draw the contents of the log to the window
     auto [w, h] = this->window_.getSize();
-    auto const x_disp = w / 30U;
-    auto const y_disp = h / 20U;
-    for (auto i = 0UL; i < this->logs_.size(); ++i) {
-      this->log_text_.setPosition(
-        {static_cast<float>(x_disp), static_cast<float>((i + 1) * y_disp)}
+    auto const x_disp = static_cast<float>(w / 30U);
+    auto const y_disp = static_cast<float>(h / 20U);
+    auto const bottom = static_cast<float>(h);
+
+    // New messages take the row of the oldest once the log is full, so
+    // only their own row is laid out
+    log_channel().drain([this](std::string_view message) {
+      size_t const row = (this->log_head_ + this->log_count_) % log_lines;
+      if (this->log_count_ == log_lines) {
+        this->log_head_ = (this->log_head_ + 1) % log_lines;
+      }
+      else {
+        this->log_count_++;
+      }
+      this->text_.set(row, message);
+    });
+    for (size_t i = 0; i < this->log_count_; i++) {
+      this->text_.move(
+        (this->log_head_ + i) % log_lines,
+        {x_disp, static_cast<float>(i + 1) * y_disp}
       );
-      this->log_text_.setString(this->logs_[i]);
-      this->window_.draw(this->log_text_);
-    }
-
-    // Log Object count
-    // this->log_text_.setPosition(
-    //   {static_cast<float>(x_disp), static_cast<float>(h - (y_disp * 2))}
-    // );
-    // this->log_text_.setString(
-    //   std::format(
-    //     "Bullet Count: {}", this->world_.bullet_capacity()
-    //     // this->enemy_pool_.capacity()
-    //   )
-    // );
-    this->window_.draw(this->log_text_);
-  }
+    }
 
-  // Update message logs
-  void SFMLWindow::update_log(std::string const& text)
-  {
-    // Upper limit on messages
-    if (this->logs_.size() == 12U) {
-      this->logs_.pop_front();
+    // Stick positions, formatted on the stack. Whole units only, so
+    // jitter does not change the text.
+    std::array<char, 64> stick{};
+    size_t stick_size = 0;
+    if (this->l_strength_.lengthSquared() > 0 ||
+        this->r_strength_.lengthSquared() > 0) {
+      auto const end = std::format_to_n(
+        stick.data(),
+        stick.size(),
+        "L: {:.0f}, {:.0f}  R: {:.0f}, {:.0f}",
+        this->l_strength_.x,
+        this->l_strength_.y,
+        this->r_strength_.x,
+        this->r_strength_.y
+      );
+      stick_size = static_cast<size_t>(end.out - stick.data());
     }
+    this->text_.set(stick_line, {stick.data(), stick_size});
+    this->text_.move(stick_line, {x_disp, bottom - (y_disp * 3.F)});
+
+    // Stats overlay
+    this->text_.set(
+      stats_line,
+      this->show_overlay_ ? std::string_view(this->overlay_)
+                          : std::string_view()
+    );
+    this->text_.move(stats_line, {x_disp, bottom - (y_disp * 2.F)});
 
-    this->logs_.emplace_back(text);
+    this->text_.draw(this->window_);
   }
 
   // Handle closing events
@@ -114,12 +147,24 @@ namespace kalika
     if (event.code == sf::Keyboard::Key::Escape) {
       this->window_.close();
     }
+    if (event.code == sf::Keyboard::Key::F3) {
+      this->show_overlay_ = !this->show_overlay_;
+    }
+    if (event.code == sf::Keyboard::Key::F12) {
+      bool const ok = profiler().write_trace("trace.json");
+      log_channel().push(
+        ok ? "Trace written to trace.json" : "Could not write trace"
+      );
+    }
   }
 
   // Button press event
   void SFMLWindow::handle(sf::Event::JoystickButtonPressed const& event)
   {
-    this->update_log(std::format("Pressed Button: {}", event.button));
+    log_channel().print("Pressed Button: {}", event.button);
+    if (!this->input_) {
+      return;
+    }
     // Set fire modes
     if (sf::Joystick::isButtonPressed(0, 1)) {
       this->bus_->emplace(GameEvent::SwitchEvent{2});
@@ -144,6 +189,10 @@ namespace kalika
   // Joystick moved event
   void SFMLWindow::handle(sf::Event::JoystickMoved const& event)
   {
+    if (!this->input_) {
+      return;
+    }
+
     // Control movement direction
     float const stick_pos = event.position;
     if (event.axis == sf::Joystick::Axis::X) {
@@ -170,19 +219,6 @@ namespace kalika
         .l_strength = this->l_strength_, .r_strength = this->r_strength_
       }
     );
-
-    // Show stick positions
-    auto print_vec = [](auto const& id, auto const& vec) {
-      return std::format("{}: {}, {}\n", id, vec.x, vec.y);
-    };
-
-    if (l_strength_.lengthSquared() > 0) {
-      this->update_log(print_vec("L", this->l_strength_));
-    }
-
-    if (r_strength_.lengthSquared() > 0) {
-      this->update_log(print_vec("R", this->r_strength_));
-    }
   }
 
   // All remaining events
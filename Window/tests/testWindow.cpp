@@ -1,3 +1,246 @@
-int main() {
-return 0;
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+
+#include <SFML/Graphics.hpp>
+
+#include <Resource/Atlas.hpp>
+#include <Window/SpriteBatch.hpp>
+
+namespace
+{
+  using kalika::SpriteBatch;
+
+  // Fail the test with a message
+  bool check(bool cond, char const* msg)
+  {
+    if (!cond) {
+      std::cerr << "FAILED: " << msg << '\n';
+    }
+    return cond;
+  }
+
+  // Check that six vertices form the quad from tl to br, as the triangles
+  // tl bl tr and tr bl br
+  bool is_quad(
+    std::span<sf::Vertex const> quad,
+    sf::Vector2f tl,
+    sf::Vector2f br,
+    sf::FloatRect uv
+  )
+  {
+    auto const [u0, v0] = uv.position;
+    auto const [u1, v1] = uv.position + uv.size;
+    std::array<sf::Vertex, 6> const corners{{
+      {{tl.x, tl.y}, {}, {u0, v0}},
+      {{tl.x, br.y}, {}, {u0, v1}},
+      {{br.x, tl.y}, {}, {u1, v0}},
+      {{br.x, tl.y}, {}, {u1, v0}},
+      {{tl.x, br.y}, {}, {u0, v1}},
+      {{br.x, br.y}, {}, {u1, v1}},
+    }};
+    for (size_t i = 0; i < corners.size(); i++) {
+      if (quad[i].position != corners[i].position ||
+          quad[i].texCoords != corners[i].texCoords) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool sprite_batch()
+  {
+    sf::Texture const first;
+    sf::Texture const second;
+    SpriteBatch batch;
+
+    // Two textures, one hidden sprite
+    sf::Sprite a(first, {{16, 0}, {16, 32}});
+    a.setPosition({100.F, 50.F});
+    sf::Sprite b(second, {{0, 0}, {8, 8}});
+    sf::Sprite c(first, {{0, 0}, {16, 32}});
+    c.setColor(sf::Color(255, 0, 0, 128));
+    sf::Sprite hidden(second, {{0, 0}, {8, 8}});
+    hidden.setColor(sf::Color::Transparent);
+    for (auto const* sprite : {&a, &b, &c, &hidden}) {
+      batch.add(*sprite);
+    }
+
+    // One call per texture, sprites of a texture in the order added
+    auto const quads = batch.vertices(&first);
+    bool ok = check(batch.draw_calls() == 2, "a call per texture") &&
+              check(quads.size() == 12, "two quads") &&
+              check(batch.vertices(&second).size() == 6, "hidden skipped");
+    if (!ok) {
+      return false;
+    }
+    ok = check(
+           is_quad(
+             quads.first(6), {100.F, 50.F}, {116.F, 82.F},
+             {{16.F, 0.F}, {16.F, 32.F}}
+           ),
+           "transformed quad"
+         ) &&
+         check(
+           is_quad(
+             quads.subspan(6), {0.F, 0.F}, {16.F, 32.F},
+             {{0.F, 0.F}, {16.F, 32.F}}
+           ),
+           "second quad"
+         ) &&
+         check(quads[6].color == c.getColor(), "tint kept") && ok;
+
+    // Clearing empties the frame but keeps the groups for the next one
+    batch.clear();
+    ok = check(batch.draw_calls() == 0, "cleared") &&
+         check(batch.vertices(&first).empty(), "nothing queued") && ok;
+    batch.add(b);
+    return check(batch.draw_calls() == 1, "reused group") &&
+           check(batch.vertices(&second).size() == 6, "refilled") && ok;
+  }
+
+  bool particle_layer()
+  {
+    sf::Texture const texture;
+    SpriteBatch batch;
+
+    // Empty layers queue nothing
+    kalika::ParticleLayer empty{};
+    empty.texture = &texture;
+    batch.add(empty);
+    bool ok = check(batch.draw_calls() == 0, "empty layer");
+
+    // Quads shrink and fade out with the particle's life
+    std::array<float, 3> const x{10.F, 20.F, 30.F};
+    std::array<float, 3> const y{5.F, 5.F, 5.F};
+    std::array<float, 3> const fade{1.F, 0.5F, 0.F};
+    sf::FloatRect const rect{{2.F, 2.F}, {4.F, 4.F}};
+    batch.add(kalika::ParticleLayer{
+      .texture = &texture,
+      .rect = rect,
+      .colour = sf::Color(255, 255, 255, 200),
+      .size = 8.F,
+      .x = x,
+      .y = y,
+      .fade = fade,
+    });
+
+    auto const quads = batch.vertices(&texture);
+    ok = check(quads.size() == 18, "a quad per particle") && ok;
+    if (!ok) {
+      return false;
+    }
+    return check(
+             is_quad(quads.first(6), {6.F, 1.F}, {14.F, 9.F}, rect),
+             "full size"
+           ) &&
+           check(
+             is_quad(quads.subspan(6, 6), {18.F, 3.F}, {22.F, 7.F}, rect),
+             "half size"
+           ) &&
+           check(quads[0].color.a == 200, "full alpha") &&
+           check(quads[6].color.a == 100, "half alpha") &&
+           check(quads[12].color.a == 0, "faded out") && ok;
+  }
+
+  // Check that no two regions on a page overlap, padding included, and
+  // that every region fits its page
+  bool packed(kalika::Atlas const& atlas)
+  {
+    using kalika::Atlas;
+    auto const region = [&](size_t idx) -> kalika::SpriteRegion const& {
+      return atlas.region(static_cast<kalika::SpriteId>(idx));
+    };
+    constexpr auto page = static_cast<int>(Atlas::page_size);
+    constexpr auto pad = static_cast<int>(Atlas::padding);
+    for (size_t i = 0; i < kalika::sprite_count; i++) {
+      auto const& a = region(i).rect;
+      if (region(i).page >= atlas.page_count() || a.position.x < 0 ||
+          a.position.y < 0 || a.position.x + a.size.x > page ||
+          a.position.y + a.size.y > page) {
+        return false;
+      }
+      for (size_t j = i + 1; j < kalika::sprite_count; j++) {
+        auto const& b = region(j).rect;
+        bool const apart =
+          region(i).page != region(j).page ||
+          a.position.x + a.size.x + pad <= b.position.x ||
+          b.position.x + b.size.x + pad <= a.position.x ||
+          a.position.y + a.size.y + pad <= b.position.y ||
+          b.position.y + b.size.y + pad <= a.position.y;
+        if (!apart) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool atlas_regions()
+  {
+    using kalika::sprite_count;
+    using kalika::sprite_sheets;
+
+    // Sheets of 24 px frames and varied heights fit one page
+    kalika::Atlas::Images images;
+    for (size_t idx = 0; idx < sprite_count; idx++) {
+      auto const frames = sprite_sheets[idx].frames;
+      auto const height = 16U + (8U * static_cast<unsigned>(idx % 3));
+      images[idx] = sf::Image({24U * frames, height});
+    }
+    kalika::Atlas atlas;
+    atlas.build(images, false);
+    bool ok = check(atlas.page_count() == 1, "one page") &&
+              check(packed(atlas), "packed");
+
+    // Every frame is a slice of its sheet, left to right, and frame
+    // indices wrap around the strip
+    bool frames_ok = true;
+    for (size_t idx = 0; idx < sprite_count; idx++) {
+      auto const& region =
+        atlas.region(static_cast<kalika::SpriteId>(idx));
+      auto const size = sf::Vector2i(images[idx].getSize());
+      frames_ok = frames_ok && region.rect.size == size &&
+                  region.frames == sprite_sheets[idx].frames &&
+                  region.frame_size == sf::Vector2i(24, size.y);
+      for (unsigned f = 0; f < region.frames; f++) {
+        auto const& rect = region.frame(f);
+        frames_ok =
+          frames_ok && rect.size == region.frame_size &&
+          rect.position.x ==
+            region.rect.position.x + (static_cast<int>(f) * 24) &&
+          rect.position.y == region.rect.position.y &&
+          region.frame(f + region.frames) == rect;
+      }
+    }
+    ok = check(frames_ok, "frame rects") && ok;
+
+    // Sheets too big to share spill onto pages of their own
+    for (auto& image : images) {
+      image = sf::Image({600U, 600U});
+    }
+    atlas.build(images, false);
+    return check(atlas.page_count() == sprite_count, "page per sheet") &&
+           check(packed(atlas), "packed pages") && ok;
+  }
+}  //namespace
+
+int main(int argc, char** argv)
+{
+  std::unordered_map<std::string_view, std::function<bool()>> const tests{
+    {"sprite_batch", sprite_batch},
+    {"particle_layer", particle_layer},
+    {"atlas_regions", atlas_regions},
+  };
+
+  if (argc < 2 || !tests.contains(argv[1])) {
+    std::cerr << "Unknown test\n";
+    return EXIT_FAILURE;
+  }
+
+  return tests.at(argv[1])() ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -1,62 +1,83 @@
 #ifndef SFML_APP_H
 #define SFML_APP_H
 
+#include <array>
+#include <optional>
+#include <string>
+
 #include <Event/GameEvent.hpp>
-#include <Object/World.hpp>
+#include <Object/InputLog.hpp>
+#include <Simulation.hpp>
 #include <Window/Window.hpp>
 
 namespace kalika
 {
-  namespace internal
-  {
-    // Texture Cache
-    sf::Texture& body_texture();
-
-    sf::Texture& reticle_texture();
-  }  // namespace internal
+  /**
+   * @brief Input recording and replay of a game session
+   */
+  struct Session {
+    // Write the input of the session here on exit, if set
+    std::string record;
+    // Drive the player from this log instead of the joystick, if set
+    std::optional<InputLog> replay;
+    // Run the replay uncapped, a tick per frame, instead of at the
+    // recorded rate
+    bool fast = false;
+  };
 
   struct SFMLGame {
-    // Constructor
-    SFMLGame(sf::Vector2u dimensions, char const* title);
+    // Constructor. The simulation ticks at sim_rate Hz, independent of
+    // the frame rate. A replay ticks at its recorded rate instead.
+    SFMLGame(
+      sf::Vector2u dimensions,
+      char const* title,
+      float sim_rate = 120.F,
+      Session session = {}
+    );
 
     /**
      * @brief Run the game
      */
     void run();
 
+    /**
+     * @brief Write a snapshot of the simulation, for crash dumps
+     */
+    bool dump(char const* path) const
+    {
+      return this->sim_.save_snapshot(path);
+    }
+
   private:
-    EventBus bus_;
+    Simulation sim_;
     SFMLWindow window_;
-    World world_;
-    Pool<Bullet> bullets_;
-
-    GameContext ctx;
 
     // Timer information
     float dt_ = 0.0F;
-    size_t frame_count_ = 0UL;
     sf::Clock clock_;
+    FixedStep timestep_;
+
+    // Recording and replay state
+    Session session_;
+    InputLog recording_;
+    std::optional<InputReplay> replay_;
+
+    // Stats overlay, formatted in place at a readable rate
+    static constexpr float overlay_period = 0.5F;
+    std::array<char, 192> overlay_{};
+    float overlay_age_ = overlay_period;
+
+    // Format the stats overlay if it is due and hand it to the window
+    void refresh_overlay();
+
+    // Particle columns of every kind, tinted and sized for drawing
+    std::array<ParticleLayer, particle_kinds> particle_layers() const;
+
+    // Check if the replay has run every recorded tick
+    bool replay_done() const;
 
-    // ====== Helper functions ====== //
-    // Process the event bus
-    void process_events();
-    // Update world context
-    void update_ctx();
-    // Get player object
-    Player& player();
-
-    // ======= Event handlers ======= //
-
-    // Move Player
-    void handle(GameEvent::MoveEvent event);
-    // Spawn Bullets
-    void handle(GameEvent::FireEvent event);
-    // Release Objects
-    void handle(GameEvent::ReleaseEvent event);
-    // Spawn Enemies
-    void handle(GameEvent::SpawnEvent event);
-    // Set Firemode
-    void handle(GameEvent::SwitchEvent event);
+    // Report and save the session once the loop is over
+    void finish_session() const;
   };
 
 }  //namespace kalika
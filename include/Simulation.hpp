@@ -0,0 +1,202 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include <SFML/System.hpp>
+
+#include <Event/GameEvent.hpp>
+#include <Jobs/JobSystem.hpp>
+#include <Object/InputLog.hpp>
+#include <Object/Rewind.hpp>
+#include <Object/Snapshot.hpp>
+#include <Object/Wave.hpp>
+#include <Object/World.hpp>
+
+namespace kalika
+{
+  /**
+   * @brief Fixed timestep accumulator
+   *
+   * Frame time is banked and paid out in whole simulation ticks. The
+   * number of catch-up ticks per frame is capped, so a long hitch drops
+   * time instead of spiralling.
+   */
+  struct FixedStep {
+    // Length of a tick in seconds
+    float step;
+    // Most ticks run for a single frame
+    size_t max_steps = 8UL;
+    float accumulator = 0.F;
+
+    FixedStep(float rate, size_t max_ticks = 8UL) :
+      step(1.F / rate), max_steps(max_ticks)
+    {}
+
+    /**
+     * @brief Bank a frame's time and return the number of ticks to run
+     */
+    size_t advance(float frame_dt);
+
+    /**
+     * @brief Fraction of a tick left over, for render interpolation
+     */
+    float alpha() const { return this->accumulator / this->step; }
+  };
+
+  /**
+   * @brief Simulation section of a snapshot
+   */
+  struct SimulationState {
+    std::uint64_t frame_count = 0;
+    // Wave progress, if a wave was loaded
+    bool has_waves = false;
+    WaveScheduler::Progress waves;
+  };
+
+  /**
+   * @brief Game state and event handling, independent of any window
+   */
+  struct Simulation {
+    // Constructor. The world update is spread over threads, the caller
+    // included.
+    Simulation(
+      sf::Vector2u dimensions,
+      size_t threads = std::max(1U, std::thread::hardware_concurrency())
+    );
+
+    /**
+     * @brief Process pending events and advance the world by dt
+     */
+    void tick(float dt);
+
+    /**
+     * @brief Stream enemies from a wave, replacing the current one. The
+     * enemy pool is built up to the wave's peak before the first spawn.
+     */
+    void set_wave(Wave wave, bool loop = true);
+
+    /**
+     * @brief Record the player input handled from now on into the log,
+     * or stop recording with nullptr. The log must outlive the
+     * recording.
+     */
+    void record(InputLog* log);
+
+    /**
+     * @brief Feed the player input from a replay at the start of every
+     * tick, or stop with nullptr. Live input should be muted meanwhile.
+     */
+    void replay(InputReplay* replay) { this->replay_ = replay; }
+
+    /**
+     * @brief Write the world, the tick counter, the wave progress and
+     * the events in flight to a snapshot file
+     */
+    bool save_snapshot(char const* path) const;
+
+    /**
+     * @brief Resume from a snapshot file written by the same build. The
+     * wave itself is not saved, so load the same wave first. Returns
+     * false, changing nothing, if the file is missing or invalid.
+     */
+    bool load_snapshot(char const* path);
+
+    /**
+     * @brief Add the state between two ticks to a snapshot
+     */
+    void write_snapshot(SnapshotWriter& out) const;
+
+    /**
+     * @brief Resume from a snapshot, see load_snapshot()
+     */
+    bool read_snapshot(SnapshotView const& in);
+
+    /**
+     * @brief Capture the state into the history at the end of every
+     * tick, or stop with nullptr. The history must outlive the capture.
+     */
+    void keep_history(RewindBuffer* history);
+
+    /**
+     * @brief Step back to the end of a tick held in the history. Later
+     * ticks are forgotten, and the simulation carries on from there.
+     */
+    bool rewind(std::uint64_t tick);
+
+    /**
+     * @brief Event bus feeding the simulation
+     */
+    EventBus& bus() { return this->bus_; }
+
+    /**
+     * @brief The simulated world
+     */
+    World& world() { return this->world_; }
+
+    World const& world() const { return this->world_; }
+
+    /**
+     * @brief Number of ticks simulated so far
+     */
+    size_t frame_count() const { return this->frame_count_; }
+
+  private:
+    EventBus bus_;
+    JobSystem jobs_;
+    World world_;
+
+    GameContext ctx;
+
+    // Enemy spawns, if a wave is loaded
+    std::optional<WaveScheduler> waves_;
+
+    // Input recording and playback, if any
+    sf::Vector2u dimensions_;
+    InputLog* recording_ = nullptr;
+    InputReplay* replay_ = nullptr;
+
+    // Recent states, if kept, and the buffers they are captured with
+    RewindBuffer* history_ = nullptr;
+    SnapshotWriter capture_;
+    std::vector<std::byte> capture_bytes_;
+
+    // Timer information
+    size_t frame_count_ = 0UL;
+    sf::Clock clock_;
+
+    // ====== Helper functions ====== //
+    // Process the event bus
+    void process_events();
+    // Get player object
+    Player& player();
+    // Tick number stored in input logs
+    std::uint32_t log_tick() const
+    {
+      return static_cast<std::uint32_t>(this->frame_count_);
+    }
+
+    // ======= Event handlers ======= //
+    // Each handler gets every event of its type from the last tick
+
+    // Move Player
+    void handle(std::span<GameEvent::MoveEvent const> events);
+    // Spawn Bullets
+    void handle(std::span<GameEvent::FireEvent const> events);
+    // Spawn bullet patterns
+    void handle(std::span<GameEvent::BurstEvent const> events);
+    // Resolve collisions
+    void handle(std::span<GameEvent::HitEvent const> events);
+    // Spawn Enemies
+    void handle(std::span<GameEvent::SpawnEvent const> events);
+    // Set Firemode
+    void handle(std::span<GameEvent::SwitchEvent const> events);
+  };
+}  //namespace kalika
+
+#endif
@@ -1,128 +1,193 @@
 #include <SFMLGame.hpp>
+#include <format>
 #include <iostream>
+#include <utility>
+
+#include <Profile/Profiler.hpp>
 
 namespace kalika
 {
   // Constructor
-  SFMLGame::SFMLGame(sf::Vector2u dimensions, char const* title) :
-    window_(dimensions, title, &(this->bus_)),
-    world_(
-      {
-        // Phase
-        .position = sf::Vector2<float>(dimensions / 2U),
-        .velocity = sf::Vector2f(sf::Vector2u(dimensions.x / 5, 0U)),
-        .dir = sf::Vector2f(0.0F, -1.0F),
-        // Textures
-        .player_tex = internal::body_texture(),
-        .reticle_tex = internal::reticle_texture(),
-        // Size
-        .size = 72.F,
-        // Reticle information
-        .radius = static_cast<float>(dimensions.y) / 4.F,
-        .responsiveness = 4.F,
-      },
-      &(this->bus_)
-    ),
-    ctx(
-      // Clock
-      this->clock_,
-      // World Boundary
-      {sf::Vector2f(dimensions) * 0.05F, sf::Vector2f(dimensions) * 0.95F},
-      // Player
-      this->world_.player,
-      // Frame count
-      this->frame_count_
-    )
-  {}
+  SFMLGame::SFMLGame(
+    sf::Vector2u dimensions,
+    char const* title,
+    float sim_rate,
+    Session session
+  ) :
+    sim_(dimensions),
+    window_(dimensions, title, &(this->sim_.bus())),
+    timestep_(sim_rate),
+    session_(std::move(session))
+  {
+    if (this->session_.replay) {
+      // Replays tick with the recorded step, bit for bit
+      this->timestep_.step = this->session_.replay->dt;
+      this->replay_.emplace(*this->session_.replay);
+      this->sim_.replay(&*this->replay_);
+      this->window_.set_input(false);
+      if (this->session_.fast) {
+        this->window_.set_frame_limit(0);
+      }
+    }
+    if (!this->session_.record.empty()) {
+      this->sim_.record(&this->recording_);
+    }
+
+    // The game still runs, without enemies, if the wave is missing
+    size_t line = 0;
+    if (auto wave = load_wave(default_wave, &line)) {
+      this->sim_.set_wave(std::move(*wave));
+    }
+    else {
+      std::clog << std::format(
+        "Bad wave {} at line {}\n", default_wave, line
+      );
+    }
+  }
 
   // Run the game
   void SFMLGame::run()
   {
     float last_stamp = 0.0F;
+    // Fast replays run a tick per frame, as fast as frames go
+    bool const fast = this->replay_ && this->session_.fast;
     // Game loop
     while (this->window_.is_active()) {
+      KALIKA_PROFILE_SCOPE("frame");
       // Timer data
       this->dt_ = this->clock_.getElapsedTime().asSeconds() - last_stamp;
       last_stamp = this->clock_.getElapsedTime().asSeconds();
-      this->frame_count_++;
 
       // 1. Handle input events
-      this->window_.handle_input();
-      // 2. Process game events
-      this->process_events();
-      // 3. Update world;
-      this->world_.update(this->ctx, this->dt_);
-      // 4. Draw world
-      this->window_.draw(this->world_.sprites());
-    }
-  }
+      {
+        KALIKA_PROFILE_SCOPE("handle_input");
+        this->window_.handle_input();
+      }
+      // 2. Process game events and update world in fixed ticks
+      {
+        KALIKA_PROFILE_SCOPE("simulate");
+        auto const ticks =
+          fast ? 1UL : this->timestep_.advance(this->dt_);
+        for (auto i = 0UL; i < ticks && !this->replay_done(); i++) {
+          this->sim_.tick(this->timestep_.step);
+        }
+        if (this->replay_done()) {
+          this->window_.close();
+        }
+      }
+      // 3. Draw world between the last two ticks
+      {
+        KALIKA_PROFILE_SCOPE("draw");
+        this->sim_.world().sync_render(
+          fast ? 1.F : this->timestep_.alpha()
+        );
+        this->refresh_overlay();
+        auto const particles = this->particle_layers();
+        this->window_.draw(this->sim_.world().sprites(), particles);
+      }
+      profiler().end_frame(this->dt_);
 
-  // Process events
-  void SFMLGame::process_events()
-  {
-    while (!this->bus_.empty()) {
-      this->bus_.front().visit([this](auto& arg) { this->handle(arg); });
-      this->bus_.pop();
+      // Report asset loading once the first frame is up
+      if (!resources().first_frame()) {
+        resources().mark_first_frame();
+        resources().report(std::clog);
+      }
     }
-  }
 
-  // Update context
-  void SFMLGame::update_ctx()
-  {}
-
-  // Get the player object
-  Player& SFMLGame::player()
-  {
-    return this->world_.player;
+    this->finish_session();
   }
 
-  // Move player
-  void SFMLGame::handle(GameEvent::MoveEvent event)
+  // Replays stop after the last recorded tick
+  bool SFMLGame::replay_done() const
   {
-    this->player().set_strength(event.l_strength, event.r_strength);
+    return this->replay_ &&
+           this->replay_->done(
+             static_cast<std::uint32_t>(this->sim_.frame_count())
+           );
   }
 
-  // Spawn Bullets
-  void SFMLGame::handle(GameEvent::FireEvent event)
+  // Save the recording and print the digest to compare runs by
+  void SFMLGame::finish_session() const
   {
-    auto const& wrapper = this->bullets_.acquire(event, &(this->bus_));
-
-    this->world_.add_bullet(wrapper);
+    auto const digest = this->sim_.world().digest();
+    if (this->replay_) {
+      std::clog << std::format(
+        "Replayed {} ticks in {:.3f} s, digest {:016x}\n",
+        this->sim_.frame_count(),
+        this->clock_.getElapsedTime().asSeconds(),
+        digest
+      );
+    }
+    if (this->session_.record.empty()) {
+      return;
+    }
+    if (this->recording_.save(this->session_.record.c_str())) {
+      std::clog << std::format(
+        "Recorded {} ticks to {}, digest {:016x}\n",
+        this->recording_.ticks,
+        this->session_.record,
+        digest
+      );
+    }
+    else {
+      std::clog << std::format(
+        "Could not write recording {}\n", this->session_.record
+      );
+    }
   }
 
-  // Release Bullets
-  void SFMLGame::handle(GameEvent::ReleaseEvent event)
+  // Frame time percentiles and object counts, twice a second so the
+  // numbers stay readable and the text is not laid out every frame
+  void SFMLGame::refresh_overlay()
   {
-    this->bullets_.release(event.idx);
-  }
-
-  // Spawn Enemies
-  void SFMLGame::handle(GameEvent::SpawnEvent)
-  {}
+    this->overlay_age_ += this->dt_;
+    if (this->overlay_age_ < overlay_period) {
+      return;
+    }
+    this->overlay_age_ = 0.F;
 
-  // Change fire modes
-  void SFMLGame::handle(GameEvent::SwitchEvent event)
-  {
-    this->player().set_mode(event.fire_id);
+    auto const stats = profiler().frame_stats();
+    auto const& world = this->sim_.world();
+    auto const end = std::format_to_n(
+      this->overlay_.data(),
+      this->overlay_.size(),
+      "frame p50 {:.2f}  p95 {:.2f}  p99 {:.2f}  max {:.2f} ms\n"
+      "bullets {}  pool {}  enemies {}  particles {}",
+      stats.p50 * 1000.F,
+      stats.p95 * 1000.F,
+      stats.p99 * 1000.F,
+      stats.max * 1000.F,
+      world.bullet_count(),
+      world.bullet_capacity(),
+      world.enemy_count(),
+      world.particles().size()
+    );
+    this->window_.set_overlay(
+      {this->overlay_.data(),
+       static_cast<size_t>(end.out - this->overlay_.data())}
+    );
   }
 
-  namespace internal
+  // Particles are drawn where the last tick left them
+  std::array<ParticleLayer, particle_kinds>
+  SFMLGame::particle_layers() const
   {
-    // Get player texture
-    sf::Texture& body_texture()
-    {
-      static sf::Texture t;
-      load_texture(t, "resources/player.png");
-      return t;
+    std::array<ParticleLayer, particle_kinds> layers{};
+    auto const& particles = this->sim_.world().particles();
+    for (size_t kind = 0; kind < particle_kinds; kind++) {
+      auto const columns =
+        particles.columns(static_cast<ParticleKind>(kind));
+      auto const sprite = columns.style.sprite;
+      layers[kind] = {
+        .texture = &atlas().texture(sprite),
+        .rect = sf::FloatRect(atlas().region(sprite).frame(0)),
+        .colour = columns.style.colour,
+        .size = columns.style.size,
+        .x = columns.x,
+        .y = columns.y,
+        .fade = columns.fade,
+      };
     }
-
-    // Get reticle texture
-    sf::Texture& reticle_texture()
-    {
-      static sf::Texture t;
-      load_texture(t, "resources/reticle.png");
-      return t;
-    }
-  }  //namespace internal
-
+    return layers;
+  }
 }  //namespace kalika
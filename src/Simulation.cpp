@@ -0,0 +1,265 @@
+#include <utility>
+
+#include <Profile/LogChannel.hpp>
+#include <Profile/Profiler.hpp>
+#include <Simulation.hpp>
+
+namespace kalika
+{
+  // Constructor
+  Simulation::Simulation(sf::Vector2u dimensions, size_t threads) :
+    jobs_(threads),
+    world_(
+      {
+        // Phase
+        .position = sf::Vector2<float>(dimensions / 2U),
+        .velocity = sf::Vector2f(sf::Vector2u(dimensions.x / 5, 0U)),
+        .dir = sf::Vector2f(0.0F, -1.0F),
+        // Sprites
+        .player_sprite = SpriteId::Player,
+        .reticle_sprite = SpriteId::Reticle,
+        // Size
+        .size = 72.F,
+        // Reticle information
+        .radius = static_cast<float>(dimensions.y) / 4.F,
+        .responsiveness = 4.F,
+      },
+      &(this->bus_),
+      &(this->jobs_)
+    ),
+    ctx(
+      // Clock
+      this->clock_,
+      // World Boundary
+      {sf::Vector2f(dimensions) * 0.05F, sf::Vector2f(dimensions) * 0.95F},
+      // Player
+      this->world_.player,
+      // Frame count
+      this->frame_count_
+    ),
+    dimensions_(dimensions)
+  {}
+
+  // Bank frame time
+  size_t FixedStep::advance(float frame_dt)
+  {
+    this->accumulator += frame_dt;
+    auto ticks = static_cast<size_t>(this->accumulator / this->step);
+
+    // Spiral-of-death cap: drop the time we cannot catch up on
+    if (ticks > this->max_steps) {
+      ticks = this->max_steps;
+      this->accumulator = std::fmod(this->accumulator, this->step);
+    }
+    else {
+      this->accumulator -= static_cast<float>(ticks) * this->step;
+    }
+
+    return ticks;
+  }
+
+  // Advance by a tick
+  void Simulation::tick(float dt)
+  {
+    KALIKA_PROFILE_SCOPE("tick");
+    this->frame_count_++;
+
+    // Recorded input goes out with the rest of the tick's events
+    if (this->replay_ != nullptr) {
+      this->replay_->feed(this->log_tick(), this->bus_);
+    }
+    if (this->recording_ != nullptr) {
+      this->recording_->dt = dt;
+      this->recording_->ticks = this->log_tick();
+    }
+
+    // Spawns due this tick are handled with the rest of the events
+    if (this->waves_) {
+      auto const pass = this->waves_->pass();
+      this->waves_->advance(dt, this->ctx.world_size, this->bus_);
+      if (this->waves_->pass() != pass) {
+        log_channel().print("Wave pass {}", this->waves_->pass());
+      }
+    }
+    this->process_events();
+    {
+      KALIKA_PROFILE_SCOPE("world_update");
+      this->world_.update(this->ctx, dt);
+    }
+
+    if (this->history_ != nullptr) {
+      KALIKA_PROFILE_SCOPE("rewind_capture");
+      this->capture_.clear();
+      this->write_snapshot(this->capture_);
+      this->capture_.bytes(this->capture_bytes_);
+      this->history_->capture(this->frame_count_, this->capture_bytes_);
+    }
+  }
+
+  // Load a wave
+  void Simulation::set_wave(Wave wave, bool loop)
+  {
+    this->world_.reserve_enemies(wave.peak);
+    this->waves_.emplace(std::move(wave), loop);
+  }
+
+  // Start or stop recording
+  void Simulation::record(InputLog* log)
+  {
+    this->recording_ = log;
+    if (log != nullptr) {
+      log->dimensions = this->dimensions_;
+    }
+  }
+
+  bool Simulation::save_snapshot(char const* path) const
+  {
+    SnapshotWriter out;
+    this->write_snapshot(out);
+    return out.save(path);
+  }
+
+  bool Simulation::load_snapshot(char const* path)
+  {
+    auto const view = SnapshotView::open(path);
+    return view && this->read_snapshot(*view);
+  }
+
+  // Everything between two ticks
+  void Simulation::write_snapshot(SnapshotWriter& out) const
+  {
+    SimulationState state;
+    state.frame_count = this->frame_count_;
+    if (this->waves_) {
+      state.has_waves = true;
+      state.waves = this->waves_->progress();
+    }
+    out.add(SnapshotSection::Simulation, 0, state);
+
+    std::uint32_t type = 0;
+    EventBus::for_each_type([&]<typename Event>() {
+      out.add(
+        SnapshotSection::Events, type++, this->bus_.published<Event>()
+      );
+    });
+    this->world_.write_snapshot(out);
+  }
+
+  // The world is restored first, as it is the only part that can fail
+  bool Simulation::read_snapshot(SnapshotView const& in)
+  {
+    auto const* state =
+      in.single<SimulationState>(SnapshotSection::Simulation, 0);
+    bool ok = state != nullptr;
+    EventBus::for_each_type([&, type = 0U]<typename Event>() mutable {
+      ok = ok && in.section<Event>(SnapshotSection::Events, type++);
+    });
+    if (!ok || !this->world_.read_snapshot(in)) {
+      return false;
+    }
+
+    this->bus_.clear();
+    EventBus::for_each_type([&, type = 0U]<typename Event>() mutable {
+      this->bus_.emplace_range(
+        *in.section<Event>(SnapshotSection::Events, type++)
+      );
+    });
+    this->frame_count_ = static_cast<size_t>(state->frame_count);
+    if (this->waves_ && state->has_waves) {
+      this->waves_->seek(state->waves);
+    }
+    return true;
+  }
+
+  // Start or stop capturing
+  void Simulation::keep_history(RewindBuffer* history)
+  {
+    this->history_ = history;
+  }
+
+  // Restore, then branch off
+  bool Simulation::rewind(std::uint64_t tick)
+  {
+    if (this->history_ == nullptr) {
+      return false;
+    }
+    auto const state = this->history_->at(tick);
+    if (!state || !this->read_snapshot(*state)) {
+      return false;
+    }
+    this->history_->truncate(tick);
+    log_channel().print("Rewound to tick {}", tick);
+    return true;
+  }
+
+  // Process events
+  void Simulation::process_events()
+  {
+    KALIKA_PROFILE_SCOPE("process_events");
+    this->bus_.swap();
+    this->bus_.drain([this](auto events) { this->handle(events); });
+  }
+
+  // Get the player object
+  Player& Simulation::player()
+  {
+    return this->world_.player;
+  }
+
+  // Move player. Only the latest stick positions matter.
+  void Simulation::handle(std::span<GameEvent::MoveEvent const> events)
+  {
+    auto const& event = events.back();
+    this->player().set_strength(event.l_strength, event.r_strength);
+    if (this->recording_ != nullptr) {
+      this->recording_->record(this->log_tick(), event);
+    }
+  }
+
+  // Spawn Bullets
+  void Simulation::handle(std::span<GameEvent::FireEvent const> events)
+  {
+    this->world_.add_bullets(events);
+  }
+
+  // Spawn bullet patterns
+  void Simulation::handle(std::span<GameEvent::BurstEvent const> events)
+  {
+    for (auto const& burst : events) {
+      this->world_.add_burst(burst);
+    }
+  }
+
+  // Resolve collisions. A bullet is spent on the first enemy it hits,
+  // and enemies killed earlier in the batch shrug off later hits.
+  void Simulation::handle(std::span<GameEvent::HitEvent const> events)
+  {
+    this->world_.hit_effects(events);
+    for (auto const& event : events) {
+      // A bullet already released carries no damage
+      if (event.kind == GameEvent::HitEvent::Kind::BulletEnemy &&
+          this->world_.release_bullet(
+            {event.behaviour, {event.idx, event.gen}}
+          )) {
+        this->world_.damage_enemy(
+          {event.target_idx, event.target_gen}, event.damage
+        );
+      }
+    }
+  }
+
+  // Spawn Enemies
+  void Simulation::handle(std::span<GameEvent::SpawnEvent const> events)
+  {
+    this->world_.add_enemies(events);
+  }
+
+  // Change fire modes. The latest switch wins.
+  void Simulation::handle(std::span<GameEvent::SwitchEvent const> events)
+  {
+    this->player().set_mode(events.back().fire_id);
+    if (this->recording_ != nullptr) {
+      this->recording_->record(this->log_tick(), events.back());
+    }
+  }
+}  //namespace kalika
@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <Profile/LogChannel.hpp>
+#include <Profile/Profiler.hpp>
+#include <Resource/Resources.hpp>
+#include <Simulation.hpp>
+
+namespace
+{
+  /**
+   * @brief Command line options of the headless run
+   */
+  struct Options {
+    size_t ticks = 36000UL;
+    float dt = 1.F / 60.F;
+    unsigned width = 1600U;
+    unsigned height = 1000U;
+    // Chrome trace of the last ticks, if set
+    std::string_view trace;
+    // Threads for the world update
+    size_t threads = std::max(1U, std::thread::hardware_concurrency());
+    // Enemy wave, or none if empty
+    std::string_view wave = kalika::default_wave;
+    // Input log to write, and one to play instead of the script
+    std::string_view record;
+    std::string_view replay;
+    // Snapshot to resume from, and one to write at the end
+    std::string_view snapshot_in;
+    std::string_view snapshot_out;
+    // Rewind history budget in MiB, none if 0
+    size_t history = 0;
+  };
+
+  // Parse a number, keeping the default on failure
+  template<typename T> void parse(std::string_view text, T& value)
+  {
+    (void)std::from_chars(text.data(), text.data() + text.size(), value);
+  }
+
+  Options parse_options(int argc, char** argv)
+  {
+    Options opts;
+    for (int i = 1; i + 1 < argc; i += 2) {
+      std::string_view const flag = argv[i];
+      std::string_view const value = argv[i + 1];
+      if (flag == "--ticks") {
+        parse(value, opts.ticks);
+      }
+      else if (flag == "--dt") {
+        parse(value, opts.dt);
+      }
+      else if (flag == "--width") {
+        parse(value, opts.width);
+      }
+      else if (flag == "--height") {
+        parse(value, opts.height);
+      }
+      else if (flag == "--trace") {
+        opts.trace = value;
+      }
+      else if (flag == "--threads") {
+        parse(value, opts.threads);
+      }
+      else if (flag == "--wave") {
+        opts.wave = value;
+      }
+      else if (flag == "--record") {
+        opts.record = value;
+      }
+      else if (flag == "--replay") {
+        opts.replay = value;
+      }
+      else if (flag == "--snapshot-in") {
+        opts.snapshot_in = value;
+      }
+      else if (flag == "--snapshot-out") {
+        opts.snapshot_out = value;
+      }
+      else if (flag == "--history") {
+        parse(value, opts.history);
+      }
+    }
+    return opts;
+  }
+
+  /**
+   * @brief Scripted input: circle around while sweeping the aim, and
+   * cycle through the fire modes
+   */
+  void script(kalika::EventBus& bus, size_t tick, float dt)
+  {
+    auto const t = static_cast<float>(tick) * dt;
+    auto const stick = [](float angle) {
+      return 100.F * sf::Vector2f(std::cos(angle), std::sin(angle));
+    };
+    bus.emplace(
+      kalika::GameEvent::MoveEvent{
+        .l_strength = stick(0.5F * t), .r_strength = stick(2.F * t)
+      }
+    );
+
+    if (tick % 600UL == 0UL) {
+      bus.emplace(kalika::GameEvent::SwitchEvent{(tick / 600UL) % 3UL});
+    }
+  }
+}  //namespace
+
+int main(int argc, char** argv)
+{
+  auto opts = parse_options(argc, argv);
+
+  // A replay runs with the tick length, world size and length it was
+  // recorded with
+  std::optional<kalika::InputLog> replay_log;
+  if (!opts.replay.empty()) {
+    replay_log = kalika::InputLog::load(std::string(opts.replay).c_str());
+    if (!replay_log) {
+      std::cerr << "Could not read replay " << opts.replay << '\n';
+      return 1;
+    }
+    opts.dt = replay_log->dt;
+    opts.width = replay_log->dimensions.x;
+    opts.height = replay_log->dimensions.y;
+    opts.ticks = replay_log->ticks;
+  }
+
+  // No window, so there is no GL context to upload textures to
+  kalika::ResourceManager::upload_textures = false;
+  kalika::Simulation sim({opts.width, opts.height}, opts.threads);
+
+  if (!opts.wave.empty()) {
+    size_t line = 0;
+    auto wave = kalika::load_wave(std::string(opts.wave).c_str(), &line);
+    if (!wave) {
+      std::cerr << std::format(
+        "Bad wave {} at line {}\n", opts.wave, line
+      );
+      return 1;
+    }
+    sim.set_wave(std::move(*wave));
+  }
+
+  std::optional<kalika::InputReplay> replay;
+  if (replay_log) {
+    sim.replay(&replay.emplace(*replay_log));
+  }
+  kalika::InputLog recording;
+  if (!opts.record.empty()) {
+    sim.record(&recording);
+  }
+
+  // A resumed run picks up the script where the snapshot left it, so
+  // --ticks counts from the start of the session
+  if (!opts.snapshot_in.empty() &&
+      !sim.load_snapshot(std::string(opts.snapshot_in).c_str())) {
+    std::cerr << "Could not read snapshot " << opts.snapshot_in << '\n';
+    return 1;
+  }
+  kalika::RewindBuffer history(opts.history << 20U);
+  if (opts.history > 0) {
+    sim.keep_history(&history);
+  }
+  size_t const first = std::min(sim.frame_count(), opts.ticks);
+  size_t const ran = std::max<size_t>(opts.ticks - first, 1);
+
+  // Run uncapped
+  size_t peak = 0;
+  size_t peak_enemies = 0;
+  size_t peak_particles = 0;
+  sf::Clock timer;
+  for (size_t tick = first; tick < opts.ticks; tick++) {
+    sf::Clock tick_timer;
+    if (!replay) {
+      script(sim.bus(), tick, opts.dt);
+    }
+    sim.tick(opts.dt);
+    peak = std::max(peak, sim.world().bullet_count());
+    peak_enemies = std::max(peak_enemies, sim.world().enemy_count());
+    peak_particles =
+      std::max(peak_particles, sim.world().particles().size());
+    kalika::profiler().end_frame(tick_timer.getElapsedTime().asSeconds());
+    // What the game would show in its log
+    kalika::log_channel().drain([](std::string_view text) {
+      std::clog << text << '\n';
+    });
+  }
+  auto const elapsed = timer.getElapsedTime().asSeconds();
+  auto const stats = kalika::profiler().frame_stats();
+
+  std::cout << std::format(
+    "ticks: {}\nwall time: {:.3f} s\nticks/s: {:.1f}\n"
+    "mean tick: {:.4f} ms\n"
+    "tick p50/p95/p99/max: {:.4f} / {:.4f} / {:.4f} / {:.4f} ms\n"
+    "peak bullets: {}\nfinal bullets: {}\n"
+    "peak enemies: {}\nenemy pool: {}\n"
+    "peak particles: {}\ndropped particles: {}\n",
+    opts.ticks - first,
+    elapsed,
+    static_cast<float>(ran) / elapsed,
+    elapsed * 1000.F / static_cast<float>(ran),
+    stats.p50 * 1000.F,
+    stats.p95 * 1000.F,
+    stats.p99 * 1000.F,
+    stats.max * 1000.F,
+    peak,
+    sim.world().bullet_count(),
+    peak_enemies,
+    sim.world().enemy_capacity(),
+    peak_particles,
+    sim.world().particles().dropped()
+  );
+
+  // Event traffic per type
+  for (auto const& stat : sim.bus().stats()) {
+    std::cout << std::format(
+      "{} events: {} total, {} peak per tick\n",
+      stat.name,
+      stat.total,
+      stat.high_water
+    );
+  }
+
+  // Memory per kind of entity
+  for (auto const& stat : sim.world().memory_stats()) {
+    std::cout << std::format(
+      "{} memory: {} live / {} slots, {} B hot + {} B cold each, "
+      "{:.1f} KiB allocated\n",
+      stat.name,
+      stat.live,
+      stat.slots,
+      stat.hot_bytes,
+      stat.cold_bytes,
+      static_cast<double>(stat.total_bytes) / 1024.0
+    );
+  }
+
+  // Equal digests mean the runs matched bit for bit
+  auto const digest = sim.world().digest();
+  std::cout << std::format("digest: {:016x}\n", digest);
+
+  // Step back as far as the history goes and run up to the end again,
+  // which must end on the same digest. Replays cannot be rerun.
+  if (!history.empty()) {
+    auto const oldest = history.oldest();
+    std::cout << std::format(
+      "history: ticks {} to {}, {:.1f} KiB\n",
+      oldest,
+      history.newest(),
+      static_cast<double>(history.bytes()) / 1024.0
+    );
+    // The recording already covers these ticks
+    sim.record(nullptr);
+    if (!replay && sim.rewind(oldest)) {
+      for (auto tick = static_cast<size_t>(oldest); tick < opts.ticks;
+           tick++) {
+        script(sim.bus(), tick, opts.dt);
+        sim.tick(opts.dt);
+      }
+      std::cout << std::format(
+        "rewound digest: {:016x}{}\n",
+        sim.world().digest(),
+        sim.world().digest() == digest ? "" : " (mismatch)"
+      );
+    }
+  }
+  kalika::log_channel().drain([](std::string_view text) {
+    std::clog << text << '\n';
+  });
+  if (!opts.snapshot_out.empty() &&
+      !sim.save_snapshot(std::string(opts.snapshot_out).c_str())) {
+    std::cerr << "Could not write snapshot to " << opts.snapshot_out
+              << '\n';
+    return 1;
+  }
+  if (!opts.record.empty() &&
+      !recording.save(std::string(opts.record).c_str())) {
+    std::cerr << "Could not write recording to " << opts.record << '\n';
+    return 1;
+  }
+
+  if (!opts.trace.empty() &&
+      !kalika::profiler().write_trace(std::string(opts.trace))) {
+    std::cerr << "Could not write trace to " << opts.trace << '\n';
+    return 1;
+  }
+
+  return 0;
+}
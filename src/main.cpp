@@ -1,15 +1,51 @@
 #include <iostream>
+#include <string_view>
+#include <utility>
 
 #include <SFMLGame.hpp>
 
-int main()
+int main(int argc, char** argv)
 {
-  kalika::SFMLGame game({1600, 1000}, "smol-shmup");
+  // --record <path> saves the session's input, --replay <path> plays
+  // one back, and --fast replays it uncapped
+  kalika::Session session;
+  for (int i = 1; i < argc; i++) {
+    std::string_view const flag = argv[i];
+    if (flag == "--fast") {
+      session.fast = true;
+    }
+    else if (flag == "--record" && i + 1 < argc) {
+      session.record = argv[++i];
+    }
+    else if (flag == "--replay" && i + 1 < argc) {
+      session.replay = kalika::InputLog::load(argv[++i]);
+      if (!session.replay) {
+        std::cerr << "Could not read replay " << argv[i] << '\n';
+        return 1;
+      }
+    }
+  }
+
+  // Simulate at 120 Hz regardless of the frame rate. Replays keep the
+  // world size and rate they were recorded with.
+  sf::Vector2u dimensions = {1600, 1000};
+  float rate = 120.F;
+  if (session.replay) {
+    dimensions = session.replay->dimensions;
+    rate = 1.F / session.replay->dt;
+  }
+  kalika::SFMLGame game(
+    dimensions, "smol-shmup", rate, std::move(session)
+  );
   // Run application
   try {
     game.run();
   } catch (std::exception const& e) {
     std::cerr << e.what() << '\n';
+    // Keep the world as it was, to load it back headless
+    if (game.dump("crash.ksnap")) {
+      std::cerr << "World saved to crash.ksnap\n";
+    }
   }
 
   return 0;